@@ -0,0 +1,174 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define OBX_CPP_FILE  // Signals objectbox.hpp to add function definitions
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "objectbox.hpp"
+
+using namespace obx;
+
+namespace {
+
+struct BenchmarkParams {
+    size_t count = 20000;
+    size_t dimensions = 768;
+    size_t rounds = 5;
+};
+
+int processArgs(int argc, char* argv[], BenchmarkParams& outParams) {
+    if (argc % 2 == 0) {
+        std::cerr << "Arguments must be given as pairs, e.g. -d 768" << std::endl;
+        return 1;
+    }
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string paramName = argv[i];
+        size_t value = std::strtoul(argv[i + 1], nullptr, 10);
+        if (value == 0) {
+            std::cerr << "Invalid value for " << paramName << ": " << argv[i + 1] << std::endl;
+            return 1;
+        }
+        if (paramName == "-n" || paramName == "--count") {
+            outParams.count = value;
+        } else if (paramName == "-d" || paramName == "--dimensions") {
+            outParams.dimensions = value;
+        } else if (paramName == "-r" || paramName == "--rounds") {
+            outParams.rounds = value;
+        } else {
+            std::cerr << "Unknown argument " << paramName << ". Expected -n, -d or -r." << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/// Straightforward scalar implementations as a baseline; note that compilers may auto-vectorize these loops
+/// depending on the optimization flags (e.g. -O3 -march=native).
+float scalarDistance(OBXVectorDistanceType type, const float* a, const float* b, size_t dimensions) {
+    float result = 0;
+    switch (type) {
+        case OBXVectorDistanceType_Euclidean:
+            for (size_t i = 0; i < dimensions; i++) result += (a[i] - b[i]) * (a[i] - b[i]);
+            return result;
+        case OBXVectorDistanceType_Manhattan:
+            for (size_t i = 0; i < dimensions; i++) result += std::fabs(a[i] - b[i]);
+            return result;
+        case OBXVectorDistanceType_DotProduct:
+            for (size_t i = 0; i < dimensions; i++) result += a[i] * b[i];
+            return 1.0f - result;
+        case OBXVectorDistanceType_Cosine: {
+            float normA = 0;
+            float normB = 0;
+            for (size_t i = 0; i < dimensions; i++) {
+                result += a[i] * b[i];
+                normA += a[i] * a[i];
+                normB += b[i] * b[i];
+            }
+            return 1.0f - result / std::sqrt(normA * normB);
+        }
+        default:
+            return 0;
+    }
+}
+
+/// Runs fn for the given rounds and returns the throughput in million distances per second.
+template <typename Fn>
+double measure(size_t rounds, size_t distancesPerRound, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; round++) fn();
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(rounds * distancesPerRound) / seconds.count() / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (!obx_has_feature(OBXFeature_VectorSearch)) {
+        std::cerr << "Vector search is not supported in this edition.\n"
+                     "Please ensure to get ObjectBox with vector search enabled."
+                  << std::endl;
+        return 1;
+    }
+
+    BenchmarkParams params;
+    if (int err = processArgs(argc, argv, params)) {
+        return err;
+    }
+
+    // Normalized random vectors, so all distance types (e.g. dot product) get valid input
+    std::mt19937 random(42);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> vectors(params.count * params.dimensions);
+    for (size_t i = 0; i < params.count; i++) {
+        float* vector = &vectors[i * params.dimensions];
+        float norm = 0;
+        for (size_t d = 0; d < params.dimensions; d++) {
+            vector[d] = distribution(random);
+            norm += vector[d] * vector[d];
+        }
+        for (size_t d = 0; d < params.dimensions; d++) vector[d] /= std::sqrt(norm);
+    }
+
+    // Many-vs-many uses a square matrix of the first vectors keeping the distance count similar to the single calls
+    size_t matrixCount = std::max(size_t(1), static_cast<size_t>(std::sqrt(static_cast<double>(params.count))));
+    std::vector<float> distances(std::max(params.count, matrixCount * matrixCount));
+    size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    volatile float sink = 0;  // Prevents the compiler from optimizing away the scalar baseline
+
+    std::cout << "Million distances per second for " << params.count << " vectors with " << params.dimensions
+              << " dimensions (" << params.rounds << " rounds):" << std::endl;
+    std::cout << std::left << std::setw(14) << "Distance" << std::right << std::setw(14) << "Scalar loop"
+              << std::setw(14) << "Single calls" << std::setw(14) << "Matrix"
+              << std::setw(14) << "Matrix (" + std::to_string(threadCount) + "T)" << std::endl;
+
+    const std::pair<OBXVectorDistanceType, const char*> types[] = {{OBXVectorDistanceType_Euclidean, "Euclidean"},
+                                                                   {OBXVectorDistanceType_Cosine, "Cosine"},
+                                                                   {OBXVectorDistanceType_DotProduct, "DotProduct"},
+                                                                   {OBXVectorDistanceType_Manhattan, "Manhattan"}};
+    for (const auto& type : types) {
+        VectorDistance distance(type.first);
+        const float* query = vectors.data();
+        const size_t n = params.count;
+        const size_t dims = params.dimensions;
+        const size_t matrixSize = matrixCount * matrixCount;
+
+        double scalar = measure(params.rounds, n, [&]() {
+            for (size_t i = 0; i < n; i++) sink = sink + scalarDistance(type.first, query, &vectors[i * dims], dims);
+        });
+        double single = measure(params.rounds, n, [&]() {
+            for (size_t i = 0; i < n; i++) distances[i] = distance(query, &vectors[i * dims], dims);
+        });
+        double matrix = measure(params.rounds, matrixSize, [&]() {
+            distance.manyToMany(vectors.data(), matrixCount, vectors.data(), matrixCount, dims, distances.data());
+        });
+        double matrixThreads = measure(params.rounds, matrixSize, [&]() {
+            distance.manyToMany(vectors.data(), matrixCount, vectors.data(), matrixCount, dims, distances.data(),
+                                threadCount);
+        });
+
+        std::cout << std::left << std::setw(14) << type.second << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << scalar << std::setw(14) << single << std::setw(14) << matrix << std::setw(14)
+                  << matrixThreads << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define OBX_CPP_FILE  // Signals objectbox.hpp to add function definitions
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+
+#include "objectbox.hpp"
+
+using namespace obx;
+
+namespace {
+
+struct BenchmarkParams {
+    size_t count = 100000;
+    size_t dimensions = 128;
+    size_t queries = 100;
+    size_t k = 10;
+};
+
+int processArgs(int argc, char* argv[], BenchmarkParams& outParams) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string paramName = argv[i];
+        size_t value = std::strtoul(argv[i + 1], nullptr, 10);
+        if (value == 0) {
+            std::cerr << "Invalid value for " << paramName << ": " << argv[i + 1] << std::endl;
+            return 1;
+        }
+        if (paramName == "-n" || paramName == "--count") {
+            outParams.count = value;
+        } else if (paramName == "-d" || paramName == "--dimensions") {
+            outParams.dimensions = value;
+        } else if (paramName == "-q" || paramName == "--queries") {
+            outParams.queries = value;
+        } else if (paramName == "-k") {
+            outParams.k = value;
+        } else {
+            std::cerr << "Unknown argument " << paramName << ". Expected -n, -d, -q or -k." << std::endl;
+            return 1;
+        }
+    }
+    if (argc % 2 == 0) {
+        std::cerr << "Arguments must be given as pairs, e.g. -n 100000" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/// Clustered random vectors; uniform noise would make nearest neighbors meaningless.
+std::vector<float> generateVectors(std::mt19937& random, size_t count, size_t dimensions) {
+    const size_t clusterCount = 64;
+    std::normal_distribution<float> centerDist(0.0f, 1.0f);
+    std::normal_distribution<float> noiseDist(0.0f, 0.3f);
+    std::vector<float> centers(clusterCount * dimensions);
+    for (float& value : centers) value = centerDist(random);
+
+    std::uniform_int_distribution<size_t> clusterDist(0, clusterCount - 1);
+    std::vector<float> vectors(count * dimensions);
+    for (size_t i = 0; i < count; i++) {
+        const float* center = centers.data() + clusterDist(random) * dimensions;
+        for (size_t d = 0; d < dimensions; d++) vectors[i * dimensions + d] = center[d] + noiseDist(random);
+    }
+    return vectors;
+}
+
+/// Exact nearest neighbors by brute force; the reference to compute the recall.
+std::vector<obx_id> exactNeighbors(const std::vector<float>& vectors, size_t dimensions, const float* query, size_t k) {
+    std::vector<std::pair<float, obx_id>> distances(vectors.size() / dimensions);
+    for (size_t i = 0; i < distances.size(); i++) {
+        float distance = obx_vector_distance_float32(OBXVectorDistanceType_Euclidean, query,
+                                                     vectors.data() + i * dimensions, dimensions);
+        distances[i] = {distance, static_cast<obx_id>(i + 1)};
+    }
+    std::partial_sort(distances.begin(), distances.begin() + k, distances.end());
+    std::vector<obx_id> ids;
+    for (size_t i = 0; i < k; i++) ids.push_back(distances[i].second);
+    return ids;
+}
+
+double recall(const std::vector<obx_id>& expected, const std::vector<VectorSearchResult>& results) {
+    std::unordered_set<obx_id> expectedIds(expected.begin(), expected.end());
+    size_t hits = 0;
+    for (const VectorSearchResult& result : results) {
+        if (expectedIds.count(result.id)) hits++;
+    }
+    return static_cast<double>(hits) / expected.size();
+}
+
+void printRow(const std::string& name, size_t bytes, size_t floatBytes, double recallAtK, double millis) {
+    std::cout << std::left << std::setw(24) << name << std::right << std::setw(12) << bytes / 1024 << " KB"
+              << std::setw(8) << std::fixed << std::setprecision(1) << static_cast<double>(floatBytes) / bytes << "x"
+              << std::setw(10) << std::setprecision(3) << recallAtK << std::setw(12) << std::setprecision(2)
+              << millis << " ms" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (!obx_has_feature(OBXFeature_VectorSearch)) {
+        std::cerr << "Vector search is not supported in this edition.\n"
+                     "Please ensure to get ObjectBox with vector search enabled."
+                  << std::endl;
+        return 1;
+    }
+
+    BenchmarkParams params;
+    if (int err = processArgs(argc, argv, params)) {
+        return err;
+    }
+    if (params.k > params.count) params.k = params.count;
+
+    std::cout << "Generating " << params.count << " vectors with " << params.dimensions << " dimensions..."
+              << std::endl;
+    std::mt19937 random(42);
+    std::vector<float> vectors = generateVectors(random, params.count, params.dimensions);
+    std::vector<float> queries = generateVectors(random, params.queries, params.dimensions);
+    std::vector<obx_id> ids(params.count);
+    for (size_t i = 0; i < ids.size(); i++) ids[i] = i + 1;
+
+    std::vector<std::vector<obx_id>> expected;
+    for (size_t q = 0; q < params.queries; q++) {
+        expected.push_back(exactNeighbors(vectors, params.dimensions, &queries[q * params.dimensions], params.k));
+    }
+
+    // Re-ranking reads the exact float32 vectors; in an app these would come from the objects (e.g. via ObjectView)
+    auto exactVector = [&](obx_id id) { return vectors.data() + (id - 1) * params.dimensions; };
+    size_t floatBytes = params.count * (params.dimensions * sizeof(float) + sizeof(obx_id));
+
+    std::cout << "Recall@" << params.k << " over " << params.queries << " queries (float32 vectors: "
+              << floatBytes / 1024 << " KB)" << std::endl;
+    std::cout << std::left << std::setw(24) << "Index" << std::right << std::setw(15) << "Memory" << std::setw(9)
+              << "Saving" << std::setw(10) << "Recall" << std::setw(15) << "Avg. query" << std::endl;
+
+    for (VectorQuantization quantization : {VectorQuantization::Int8, VectorQuantization::Binary}) {
+        QuantizedVectorIndex index(quantization, params.dimensions);
+        index.train(vectors.data(), params.count);
+        index.add(ids, vectors.data());
+        std::string name = quantization == VectorQuantization::Int8 ? "int8" : "binary";
+
+        for (size_t rerankFactor : {0, 2, 5, 10}) {
+            double recallSum = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t q = 0; q < params.queries; q++) {
+                const float* query = &queries[q * params.dimensions];
+                std::vector<VectorSearchResult> results =
+                    rerankFactor == 0 ? index.search(query, params.k)
+                                      : index.search(query, params.k, params.k * rerankFactor, exactVector);
+                recallSum += recall(expected[q], results);
+            }
+            auto duration = std::chrono::steady_clock::now() - start;
+            double millis = std::chrono::duration<double, std::milli>(duration).count() / params.queries;
+            std::string rowName =
+                rerankFactor == 0 ? name : name + " + re-rank " + std::to_string(params.k * rerankFactor);
+            printRow(rowName, index.memoryBytes(), floatBytes, recallSum / params.queries, millis);
+        }
+    }
+    return 0;
+}
@@ -20,10 +20,23 @@
 
 #include <algorithm>
 #include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "objectbox.h"
@@ -310,6 +323,8 @@ class BoxTypeless;
 template <class T>
 class AsyncBox;
 
+class GroupCommit;
+
 class Transaction;
 
 class Sync;
@@ -667,6 +682,354 @@ public:
 /// Transactions can be started in read (only) or write mode.
 enum class TxMode { READ, WRITE };
 
+/// \brief A lock-free latency distribution using power-of-two microsecond buckets; cheap enough to record always.
+class LatencyHistogram {
+public:
+    /// Bucket i counts latencies below 2^i microseconds (and at least 2^(i-1)); the last bucket counts all above.
+    enum { BucketCount = 32 };
+
+    /// A consistent-enough copy of the histogram values (taken without locking, so values may be slightly apart).
+    struct Snapshot {
+        uint64_t count;        ///< Number of recorded latencies
+        uint64_t totalMicros;  ///< Sum of all recorded latencies
+        uint64_t maxMicros;    ///< Highest recorded latency
+        uint64_t buckets[BucketCount];
+
+        double meanMicros() const { return count ? static_cast<double>(totalMicros) / count : 0.0; }
+
+        /// Approximates the given percentile (e.g. 0.99) by the upper bound of the bucket containing it.
+        uint64_t percentileMicros(double percentile) const;
+    };
+
+    LatencyHistogram() {
+        for (std::atomic<uint64_t>& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+
+    void record(std::chrono::steady_clock::duration duration);
+
+    Snapshot snapshot() const;
+
+private:
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> totalMicros_{0};
+    std::atomic<uint64_t> maxMicros_{0};
+    std::atomic<uint64_t> buckets_[BucketCount];
+};
+
+/// Counters of a single entity type; see StoreMetrics::entity().
+struct EntityMetrics {
+    obx_schema_id typeId;
+    uint64_t puts;  ///< Objects put via Box
+    uint64_t gets;  ///< Objects read via Box (found objects only)
+};
+
+/// A copy of all StoreMetrics values at some point in time; see StoreMetrics::snapshot().
+struct StoreMetricsSnapshot {
+    LatencyHistogram::Snapshot readTx;   ///< Durations of (top level) read transactions, i.e. from begin to close
+    LatencyHistogram::Snapshot writeTx;  ///< Durations of (top level) write transactions, including their commit
+    LatencyHistogram::Snapshot commit;   ///< Commit durations, including syncing to disk (top level transactions only)
+    LatencyHistogram::Snapshot query;    ///< Query execution durations (e.g. find(), count(), remove())
+    uint64_t writeTxAborted;             ///< Write transactions closed without success(), i.e. rolled back
+    uint64_t readersActive;              ///< Read transactions currently open
+    uint64_t readersPeak;                ///< Highest number of concurrently open read transactions
+    std::vector<EntityMetrics> entities;  ///< Per entity type counters (only types that were accessed via Box)
+};
+
+/// A query execution that took at least the threshold given to StoreMetrics::onSlowQuery().
+struct SlowQuery {
+    const char* operation;                 ///< The executing method, e.g. "find" or "count"
+    std::string description;               ///< The query conditions with their current parameter values
+    std::chrono::microseconds duration;    ///< The execution time
+    uint64_t resultCount;                  ///< Objects (or IDs) returned, counted or removed; 0 for visitor methods
+};
+
+/// \brief Metrics of a Store recorded by this C++ API: transactions, commits, queries and per entity type counters.
+///
+/// Enable via Store::enableMetrics() right after opening the store; Box and Query objects created before that are not
+/// tracked. Recording uses relaxed atomics only (plus clock reads for durations), so it is cheap enough to keep
+/// enabled in production. snapshot() may be called from any thread, e.g. a thread periodically exporting the values.
+/// Only operations going through this C++ API are tracked (e.g. not the async queue of AsyncBox), and nested
+/// transactions are counted as part of their top level transaction. Reader slots (see Options::maxReaders()) are held
+/// per thread that did read, so readersPeak is a lower bound of the reader slots in use.
+class StoreMetrics {
+public:
+    /// Thread-safe counters of a single entity type; stable address once created.
+    class EntityCounters {
+        friend StoreMetrics;
+        std::atomic<uint64_t> puts_{0};
+        std::atomic<uint64_t> gets_{0};
+
+    public:
+        void addPuts(uint64_t count) { puts_.fetch_add(count, std::memory_order_relaxed); }
+        void addGets(uint64_t count) { gets_.fetch_add(count, std::memory_order_relaxed); }
+    };
+
+    StoreMetrics() = default;
+
+    StoreMetrics(const StoreMetrics&) = delete;
+
+    /// The counters for the given entity type (created on first access).
+    EntityCounters& entity(obx_schema_id typeId);
+
+    /// Called by Transaction when a top level transaction begins.
+    void txBegin(TxMode mode);
+
+    /// Called by Transaction when a top level transaction ends.
+    /// @param commitDuration the time success() took to commit; zero if the transaction was not committed
+    void txEnd(TxMode mode, std::chrono::steady_clock::duration duration, bool committed,
+               std::chrono::steady_clock::duration commitDuration);
+
+    /// Calls the given callback for each query execution taking at least the given threshold, e.g. to find queries
+    /// that lack an index. The callback is called on the thread executing the query, which it thus delays.
+    /// @param callback the callback or nullptr to disable reporting slow queries
+    StoreMetrics& onSlowQuery(std::chrono::microseconds threshold, std::function<void(const SlowQuery&)> callback);
+
+    /// Called after a query was executed.
+    /// @returns true if the execution was slow and should be passed to reportSlowQuery()
+    bool recordQuery(std::chrono::steady_clock::duration duration) {
+        query_.record(duration);
+        int64_t threshold = slowQueryMicros_.load(std::memory_order_relaxed);
+        return threshold >= 0 && std::chrono::duration_cast<std::chrono::microseconds>(duration).count() >= threshold;
+    }
+
+    void reportSlowQuery(const SlowQuery& slowQuery);
+
+    StoreMetricsSnapshot snapshot();
+
+private:
+    LatencyHistogram readTx_;
+    LatencyHistogram writeTx_;
+    LatencyHistogram commit_;
+    LatencyHistogram query_;
+    std::atomic<uint64_t> writeTxAborted_{0};
+    std::atomic<uint64_t> readersActive_{0};
+    std::atomic<uint64_t> readersPeak_{0};
+    std::atomic<int64_t> slowQueryMicros_{-1};  ///< Negative if slow queries are not reported
+    std::mutex slowQueryMutex_;
+    std::function<void(const SlowQuery&)> slowQueryCallback_;
+    std::mutex entitiesMutex_;
+    std::vector<std::pair<obx_schema_id, std::unique_ptr<EntityCounters>>> entities_;  ///< Few types: linear search
+};
+
+#ifdef OBX_CPP_FILE
+uint64_t LatencyHistogram::Snapshot::percentileMicros(double percentile) const {
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile * count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BucketCount; i++) {
+        seen += buckets[i];
+        if (seen >= rank && seen > 0) return i + 1 < BucketCount ? std::min(uint64_t(1) << i, maxMicros) : maxMicros;
+    }
+    return maxMicros;
+}
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration duration) {
+    int64_t signedMicros = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    uint64_t micros = signedMicros > 0 ? static_cast<uint64_t>(signedMicros) : 0;
+    size_t bucket = 0;
+    while (bucket + 1 < BucketCount && (uint64_t(1) << bucket) <= micros) bucket++;
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    totalMicros_.fetch_add(micros, std::memory_order_relaxed);
+    uint64_t max = maxMicros_.load(std::memory_order_relaxed);
+    while (micros > max && !maxMicros_.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot result;
+    result.count = count_.load(std::memory_order_relaxed);
+    result.totalMicros = totalMicros_.load(std::memory_order_relaxed);
+    result.maxMicros = maxMicros_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < BucketCount; i++) result.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    return result;
+}
+
+StoreMetrics::EntityCounters& StoreMetrics::entity(obx_schema_id typeId) {
+    std::lock_guard<std::mutex> lock(entitiesMutex_);
+    for (std::pair<obx_schema_id, std::unique_ptr<EntityCounters>>& entry : entities_) {
+        if (entry.first == typeId) return *entry.second;
+    }
+    entities_.emplace_back(typeId, std::unique_ptr<EntityCounters>(new EntityCounters()));
+    return *entities_.back().second;
+}
+
+void StoreMetrics::txBegin(TxMode mode) {
+    if (mode != TxMode::READ) return;
+    uint64_t active = readersActive_.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t peak = readersPeak_.load(std::memory_order_relaxed);
+    while (active > peak && !readersPeak_.compare_exchange_weak(peak, active, std::memory_order_relaxed)) {
+    }
+}
+
+void StoreMetrics::txEnd(TxMode mode, std::chrono::steady_clock::duration duration, bool committed,
+                         std::chrono::steady_clock::duration commitDuration) {
+    if (mode == TxMode::READ) {
+        readersActive_.fetch_sub(1, std::memory_order_relaxed);
+        readTx_.record(duration);
+    } else {
+        writeTx_.record(duration);
+        if (committed) {
+            commit_.record(commitDuration);
+        } else {
+            writeTxAborted_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+StoreMetrics& StoreMetrics::onSlowQuery(std::chrono::microseconds threshold,
+                                        std::function<void(const SlowQuery&)> callback) {
+    std::lock_guard<std::mutex> lock(slowQueryMutex_);
+    slowQueryMicros_ = callback ? std::max<int64_t>(0, threshold.count()) : -1;
+    slowQueryCallback_ = std::move(callback);
+    return *this;
+}
+
+void StoreMetrics::reportSlowQuery(const SlowQuery& slowQuery) {
+    std::function<void(const SlowQuery&)> callback;
+    {
+        std::lock_guard<std::mutex> lock(slowQueryMutex_);
+        callback = slowQueryCallback_;
+    }
+    if (callback) callback(slowQuery);
+}
+
+StoreMetricsSnapshot StoreMetrics::snapshot() {
+    StoreMetricsSnapshot result;
+    result.readTx = readTx_.snapshot();
+    result.writeTx = writeTx_.snapshot();
+    result.commit = commit_.snapshot();
+    result.query = query_.snapshot();
+    result.writeTxAborted = writeTxAborted_.load(std::memory_order_relaxed);
+    result.readersActive = readersActive_.load(std::memory_order_relaxed);
+    result.readersPeak = readersPeak_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(entitiesMutex_);
+    for (const std::pair<obx_schema_id, std::unique_ptr<EntityCounters>>& entry : entities_) {
+        result.entities.push_back({entry.first, entry.second->puts_.load(std::memory_order_relaxed),
+                                   entry.second->gets_.load(std::memory_order_relaxed)});
+    }
+    return result;
+}
+#endif  // OBX_CPP_FILE
+
+/// \brief In-process cache of the objects (FlatBuffers bytes) of one entity type by ID, serving hot objects without
+/// accessing the DB; enable via Box::enableObjectCache() or Store::enableObjectCache().
+///
+/// A cache hit does not start a transaction (thus takes no reader slot): entries are immutable and each slot has its
+/// own mutex, which is only held to exchange the entry's shared_ptr; thus, a hit never waits for the database.
+/// Entries are versioned: advancing the version (the changed IDs are not known) invalidates all cached entries.
+/// Commits through this API (Box puts and removes, Query::remove(), Transaction::success()) advance the version right
+/// after committing, so the committing thread reads its own changes. Other commits (e.g. by the async queue or sync)
+/// advance it once the core notifies the cache's observer, which may happen after the commit returned (and possibly
+/// on another thread). Until then, a hit may return the previous state of such an object.
+/// Thus, the cache pays off for read-mostly types with a set of hot objects that tolerate this.
+/// The cache is direct-mapped, i.e. each ID maps to a single slot, and IDs sharing a slot replace each other.
+/// Only reads outside of transactions use the cache; inside a transaction, the transaction's state is read instead.
+class ObjectCache {
+public:
+    /// An immutable cached object.
+    struct Entry {
+        obx_id id;
+        uint64_t version;           ///< The cache version the object was read at
+        std::vector<uint8_t> data;  ///< FlatBuffers bytes of the object
+    };
+
+private:
+    struct Slot {
+        std::mutex mutex;
+        std::shared_ptr<const Entry> entry;  ///< Guarded by mutex
+    };
+
+    const size_t slotMask_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> version_{1};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    OBX_observer* cObserver_ = nullptr;
+
+public:
+    /// @param capacity the number of slots, rounded up to the next power of two
+    ObjectCache(OBX_store* cStore, obx_schema_id entityTypeId, size_t capacity);
+
+    /// Can't be copied or moved as the C observer refers to this instance
+    ObjectCache(const ObjectCache&) = delete;
+
+    ~ObjectCache() { close(); }
+
+    /// The number of slots, i.e. the maximum number of cached objects.
+    size_t capacity() const { return slotMask_ + 1; }
+
+    /// The number of reads served from the cache.
+    uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+
+    /// The number of reads not served from the cache (including reads of IDs that do not exist).
+    uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
+    /// The current version; get it before starting the read transaction of an object passed to put().
+    uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+    /// @returns the entry of the given ID if it was cached at the current version, otherwise null (counted as a miss)
+    std::shared_ptr<const Entry> find(obx_id id) {
+        std::shared_ptr<const Entry> entry;
+        {
+            Slot& slot = slots_[slotIndex(id)];
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            entry = slot.entry;
+        }
+        if (entry && entry->id == id && entry->version == version()) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return entry;
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    /// Caches the given object bytes, unless the version changed since they were read.
+    /// @param version the version() obtained before the read transaction began
+    void put(obx_id id, uint64_t version, const void* data, size_t size) {
+        if (version != this->version()) return;  // Stale already; would never be returned
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        std::shared_ptr<const Entry> entry(new Entry{id, version, std::vector<uint8_t>(bytes, bytes + size)});
+        Slot& slot = slots_[slotIndex(id)];
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        slot.entry.swap(entry);  // The previous entry is released after unlocking
+    }
+
+    /// Invalidates all cached objects; called after commits changing the entity type (see the class docs).
+    void invalidate() { version_.fetch_add(1, std::memory_order_acq_rel); }
+
+    /// Stops observing commits and invalidates all cached objects; called by Store::close().
+    void close() {
+        if (cObserver_) {
+            obx_observer_close(cObserver_);
+            cObserver_ = nullptr;
+        }
+        invalidate();
+    }
+
+private:
+    size_t slotIndex(obx_id id) const {
+        return static_cast<size_t>((id * 0x9E3779B97F4A7C15ull) >> 32) & slotMask_;  // Fibonacci hashing
+    }
+
+    static size_t slotCount(size_t capacity) {
+        OBX_VERIFY_ARGUMENT(capacity > 0 && capacity <= (SIZE_MAX >> 1) + 1);
+        size_t count = 1;
+        while (count < capacity) count <<= 1;
+        return count;
+    }
+};
+
+#ifdef OBX_CPP_FILE
+ObjectCache::ObjectCache(OBX_store* cStore, obx_schema_id entityTypeId, size_t capacity)
+    : slotMask_(slotCount(capacity) - 1), slots_(new Slot[slotMask_ + 1]) {
+    cObserver_ = obx_observe_single_type(
+        cStore, entityTypeId, [](void* userData) { static_cast<ObjectCache*>(userData)->invalidate(); }, this);
+    internal::checkPtrOrThrow(cObserver_, "Could not observe the entity type for the object cache");
+}
+#endif
+
 /// \brief A ObjectBox store represents a database storing data in a given directory on a local file system.
 ///
 /// Once opened using one of the constructors, Store is an entry point to data access APIs such as Box, Query, and
@@ -678,6 +1041,10 @@ class Store {
     const bool owned_;  ///< whether the store pointer is owned (true except for SyncServer::store())
     std::shared_ptr<Closable> syncClient_;
     std::mutex syncClientMutex_;
+    std::atomic<StoreMetrics*> metrics_{nullptr};  ///< Owned; set once by enableMetrics()
+    std::mutex objectCachesMutex_;
+    std::vector<std::pair<obx_schema_id, std::unique_ptr<ObjectCache>>> objectCaches_;
+    std::atomic<bool> hasObjectCaches_{false};  ///< Avoids locking in objectCache() if there are none
 
     friend Sync;
     friend SyncClient;
@@ -819,6 +1186,25 @@ public:
     /// @returns false if shutting down or an error occurred
     bool awaitSubmitted() { return obx_store_await_async_submitted(cPtr()); }
 
+    /// Enables recording metrics of this store (if not enabled yet); see StoreMetrics for what is recorded.
+    /// @returns the metrics, which are valid until the store is destroyed
+    StoreMetrics& enableMetrics();
+
+    /// @returns the metrics if enabled via enableMetrics(), otherwise nullptr
+    StoreMetrics* metrics() const { return metrics_.load(std::memory_order_acquire); }
+
+    /// Enables caching objects of the given entity type (if not enabled yet); see ObjectCache.
+    /// Boxes pick up the cache when they are created; Box objects created before that do not use the cache.
+    /// @param capacity the maximum number of cached objects; ignored if the cache was already enabled
+    /// @returns the cache, which is valid until the store is destroyed
+    ObjectCache& enableObjectCache(obx_schema_id entityTypeId, size_t capacity);
+
+    /// @returns the cache of the given entity type if enabled via enableObjectCache(), otherwise nullptr
+    ObjectCache* objectCache(obx_schema_id entityTypeId);
+
+    /// Invalidates all object caches; called after commits through this API that may change any entity type.
+    void invalidateObjectCaches();
+
     /// Backs up the store DB to the given backup-file, using the given flags.
     /// Note: backup is a server-only feature.
     /// @param flags 0 for defaults or OBXBackupFlags bit flags
@@ -850,13 +1236,57 @@ public:
 
 #ifdef OBX_CPP_FILE
 
-Store::Store(Store&& source) noexcept : cStore_(source.cStore_.load()), owned_(source.owned_) {
+Store::Store(Store&& source) noexcept
+    : cStore_(source.cStore_.load()), owned_(source.owned_), metrics_(source.metrics_.exchange(nullptr)) {
     source.cStore_ = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(source.objectCachesMutex_);
+        objectCaches_ = std::move(source.objectCaches_);
+        hasObjectCaches_ = !objectCaches_.empty();
+        source.hasObjectCaches_ = false;
+    }
     std::lock_guard<std::mutex> lock(source.syncClientMutex_);
     syncClient_ = std::move(source.syncClient_);
 }
 
-Store::~Store() { close(); }
+Store::~Store() {
+    close();
+    delete metrics_.load();
+}
+
+StoreMetrics& Store::enableMetrics() {
+    StoreMetrics* metrics = metrics_.load();
+    if (metrics) return *metrics;
+    std::unique_ptr<StoreMetrics> newMetrics(new StoreMetrics());
+    if (metrics_.compare_exchange_strong(metrics, newMetrics.get())) return *newMetrics.release();
+    return *metrics;  // Enabled concurrently by another thread
+}
+
+ObjectCache& Store::enableObjectCache(obx_schema_id entityTypeId, size_t capacity) {
+    std::lock_guard<std::mutex> lock(objectCachesMutex_);
+    for (std::pair<obx_schema_id, std::unique_ptr<ObjectCache>>& entry : objectCaches_) {
+        if (entry.first == entityTypeId) return *entry.second;
+    }
+    std::unique_ptr<ObjectCache> cache(new ObjectCache(cPtr(), entityTypeId, capacity));
+    objectCaches_.emplace_back(entityTypeId, std::move(cache));
+    hasObjectCaches_ = true;
+    return *objectCaches_.back().second;
+}
+
+ObjectCache* Store::objectCache(obx_schema_id entityTypeId) {
+    if (!hasObjectCaches_.load(std::memory_order_acquire)) return nullptr;
+    std::lock_guard<std::mutex> lock(objectCachesMutex_);
+    for (std::pair<obx_schema_id, std::unique_ptr<ObjectCache>>& entry : objectCaches_) {
+        if (entry.first == entityTypeId) return entry.second.get();
+    }
+    return nullptr;
+}
+
+void Store::invalidateObjectCaches() {
+    if (!hasObjectCaches_.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> lock(objectCachesMutex_);
+    for (std::pair<obx_schema_id, std::unique_ptr<ObjectCache>>& entry : objectCaches_) entry.second->invalidate();
+}
 
 void Store::close() {
     {
@@ -880,6 +1310,12 @@ void Store::close() {
         }
     }
 
+    {
+        // Observers must be closed before the store; the caches stay allocated as Box objects may still refer to them
+        std::lock_guard<std::mutex> lock(objectCachesMutex_);
+        for (std::pair<obx_schema_id, std::unique_ptr<ObjectCache>>& entry : objectCaches_) entry.second->close();
+    }
+
     if (owned_) {
         OBX_store* storeToClose = cStore_.exchange(nullptr);  // Close exactly once
         obx_store_close(storeToClose);
@@ -919,7 +1355,11 @@ void Store::prepareToClose() {
 /// and actually commit.
 class Transaction {
     TxMode mode_;
+    OBX_store* cStore_;  ///< The store this transaction was started for; not owned
     OBX_txn* cTxn_;
+    StoreMetrics* metrics_ = nullptr;  ///< Set for top level transactions if the store has metrics enabled
+    Store* writeStore_ = nullptr;      ///< Set for top level write transactions to invalidate object caches on commit
+    std::chrono::steady_clock::time_point begin_;
 
 public:
     Transaction(Store& store, TxMode mode);
@@ -928,7 +1368,17 @@ public:
     Transaction(const Transaction&) = delete;
 
     /// Move constructor, used by Store::tx()
-    Transaction(Transaction&& source) noexcept : mode_(source.mode_), cTxn_(source.cTxn_) { source.cTxn_ = nullptr; }
+    Transaction(Transaction&& source) noexcept
+        : mode_(source.mode_),
+          cStore_(source.cStore_),
+          cTxn_(source.cTxn_),
+          metrics_(source.metrics_),
+          writeStore_(source.writeStore_),
+          begin_(source.begin_) {
+        source.cTxn_ = nullptr;
+        source.metrics_ = nullptr;
+        source.writeStore_ = nullptr;
+    }
 
     /// Copy-and-swap style
     Transaction& operator=(Transaction source);
@@ -939,6 +1389,9 @@ public:
     /// A Transaction is active if it was not ended via success(), close() or moving.
     bool isActive() { return cTxn_ != nullptr; }
 
+    /// @returns true if this transaction was started for the given store
+    bool isForStore(const Store& store) const { return cStore_ == store.cPtr(); }
+
     /// The transaction pointer of the ObjectBox C API.
     /// @throws if this Transaction was already closed or moved
     OBX_txn* cPtr() const;
@@ -962,18 +1415,59 @@ public:
 
     /// Cumulative change (delta) of data size by this pending transaction (uncommitted).
     int64_t getDataSizeChange() const;
+
+private:
+    friend BoxTypeless;
+    friend GroupCommit;
+
+    /// The number of active Transaction objects of the given store on the current thread, i.e. 0 before a top level
+    /// transaction begins. Kept per store, as transactions of different stores do not nest.
+    static size_t threadDepth(OBX_store* store) { return changeThreadDepth(store, 0); }
+
+    /// Increments (delta 1) or decrements (delta -1) threadDepth() of the given store; @returns the previous depth.
+    static size_t changeThreadDepth(OBX_store* store, int delta);
 };
 
 #ifdef OBX_CPP_FILE
 
 Transaction::Transaction(Store& store, TxMode mode)
-    : mode_(mode), cTxn_(mode == TxMode::WRITE ? obx_txn_write(store.cPtr()) : obx_txn_read(store.cPtr())) {
+    : mode_(mode),
+      cStore_(store.cPtr()),
+      cTxn_(mode == TxMode::WRITE ? obx_txn_write(cStore_) : obx_txn_read(cStore_)) {
     internal::checkPtrOrThrow(cTxn_, "Can not start transaction");
+    if (changeThreadDepth(cStore_, 1) == 0) {
+        if (mode_ == TxMode::WRITE) writeStore_ = &store;
+        if ((metrics_ = store.metrics()) != nullptr) {
+            metrics_->txBegin(mode_);
+            begin_ = std::chrono::steady_clock::now();
+        }
+    }
+}
+
+size_t Transaction::changeThreadDepth(OBX_store* store, int delta) {
+    // Only stores with active transactions on this thread have an entry, so this is typically tiny
+    static thread_local std::vector<std::pair<OBX_store*, size_t>> depths;
+    for (size_t i = 0; i < depths.size(); i++) {
+        if (depths[i].first != store) continue;
+        size_t depth = depths[i].second;
+        if (delta > 0) depths[i].second++;
+        if (delta < 0 && --depths[i].second == 0) {
+            depths[i] = depths.back();
+            depths.pop_back();
+        }
+        return depth;
+    }
+    if (delta > 0) depths.emplace_back(store, 1);
+    return 0;
 }
 
 Transaction& Transaction::operator=(Transaction source) {
     std::swap(mode_, source.mode_);
+    std::swap(cStore_, source.cStore_);
     std::swap(cTxn_, source.cTxn_);
+    std::swap(metrics_, source.metrics_);
+    std::swap(writeStore_, source.writeStore_);
+    std::swap(begin_, source.begin_);
     return *this;
 }
 
@@ -986,13 +1480,35 @@ void Transaction::success() {
     OBX_txn* txn = cTxn_;
     OBX_VERIFY_STATE(txn);
     cTxn_ = nullptr;
-    internal::checkErrOrThrow(obx_txn_success(txn));
+    changeThreadDepth(cStore_, -1);
+    Store* writeStore = writeStore_;
+    writeStore_ = nullptr;
+    if (metrics_ == nullptr) {
+        internal::checkErrOrThrow(obx_txn_success(txn));
+        if (writeStore) writeStore->invalidateObjectCaches();
+        return;
+    }
+
+    std::chrono::steady_clock::time_point commitBegin = std::chrono::steady_clock::now();
+    obx_err err = obx_txn_success(txn);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    metrics_->txEnd(mode_, end - begin_, err == OBX_SUCCESS && mode_ == TxMode::WRITE, end - commitBegin);
+    metrics_ = nullptr;
+    internal::checkErrOrThrow(err);
+    if (writeStore) writeStore->invalidateObjectCaches();
 }
 
 obx_err Transaction::closeNoThrow() {
     OBX_txn* txnToClose = cTxn_;
     cTxn_ = nullptr;
-    return obx_txn_close(txnToClose);
+    if (txnToClose) changeThreadDepth(cStore_, -1);
+    writeStore_ = nullptr;  // Not committed
+    obx_err err = obx_txn_close(txnToClose);
+    if (metrics_) {
+        metrics_->txEnd(mode_, std::chrono::steady_clock::now() - begin_, false, {});
+        metrics_ = nullptr;
+    }
+    return err;
 }
 
 void Transaction::close() { internal::checkErrOrThrow(closeNoThrow()); }
@@ -1015,6 +1531,59 @@ Transaction Store::txWrite() { return tx(TxMode::WRITE); }
 
 #endif
 
+/// \brief Read-only, zero-copy access to the FlatBuffers bytes of an object as stored in the database.
+///
+/// Unlike reading regular objects, views do not decode any data and do not allocate; they just point to the data.
+/// Generated bindings may provide a typed view with field accessors as EntityT::_OBX_MetaInfo::View, which must be
+/// constructible from (const void* data, size_t size), e.g. by deriving from this class. If the bindings do not
+/// provide such a type, ObjectView<EntityT> is used instead (see EntityViewType).
+/// \attention The viewed data is only valid as long as the (top) transaction is still active and no write operation
+///            (e.g. put/remove) was executed. Accessing data after this is undefined behavior.
+template <typename EntityT>
+class ObjectView {
+protected:
+    const void* data_;
+    size_t size_;
+
+public:
+    ObjectView(const void* data, size_t size) : data_(data), size_(size) {}
+
+    /// The raw FlatBuffers bytes of the object.
+    const void* data() const { return data_; }
+
+    /// The size of the raw FlatBuffers bytes.
+    size_t size() const { return size_; }
+
+#ifndef OBX_DISABLE_FLATBUFFERS
+    /// The FlatBuffers table to access fields directly, e.g. table()->GetField<int64_t>(vtableOffset, 0).
+    const flatbuffers::Table* table() const { return flatbuffers::GetRoot<flatbuffers::Table>(data_); }
+#endif
+
+    /// Reads (copies) the viewed data into a regular object, e.g. to keep it beyond the transaction.
+    EntityT toObject() const { return EntityT::_OBX_MetaInfo::fromFlatBuffer(data_, size_); }
+
+    /// Reads (copies) the viewed data into the given object, e.g. to keep it beyond the transaction.
+    void toObject(EntityT& outObject) const { EntityT::_OBX_MetaInfo::fromFlatBuffer(data_, size_, outObject); }
+};
+
+namespace internal {
+template <typename...>
+struct VoidType {
+    using type = void;
+};
+}  // namespace internal
+
+/// Resolves the view type of an entity: EntityT::_OBX_MetaInfo::View if the bindings provide it, or ObjectView.
+template <typename EntityT, typename = void>
+struct EntityViewType {
+    using type = ObjectView<EntityT>;
+};
+
+template <typename EntityT>
+struct EntityViewType<EntityT, typename internal::VoidType<typename EntityT::_OBX_MetaInfo::View>::type> {
+    using type = typename EntityT::_OBX_MetaInfo::View;
+};
+
 namespace {  // internal
 /// Internal cursor wrapper for convenience and RAII.
 class CursorTx {
@@ -1102,6 +1671,44 @@ struct CollectingVisitorUniquePtr {
     }
 };
 
+/// Collects views on all visited data; does not copy any data.
+template <typename ViewT>
+struct CollectingViewVisitor {
+    std::vector<ViewT> items;
+
+    static bool visit(const void* data, size_t size, void* userData) {
+        CollectingViewVisitor<ViewT>* self = static_cast<CollectingViewVisitor<ViewT>*>(userData);
+        assert(self);
+        self->items.emplace_back(data, size);
+        return true;
+    }
+};
+
+/// Forwards visited data as views to a C++ callable returning a bool (false to stop visiting).
+/// Exceptions must not pass through the C API; thus they are kept and must be re-thrown via rethrowIfThrown().
+template <typename ViewT, typename Visitor>
+struct ForwardingViewVisitor {
+    Visitor& visitor;
+    std::exception_ptr exception;
+
+    explicit ForwardingViewVisitor(Visitor& target) : visitor(target) {}
+
+    static bool visit(const void* data, size_t size, void* userData) {
+        ForwardingViewVisitor<ViewT, Visitor>* self = static_cast<ForwardingViewVisitor<ViewT, Visitor>*>(userData);
+        assert(self);
+        try {
+            return self->visitor(ViewT(data, size));
+        } catch (...) {
+            self->exception = std::current_exception();
+            return false;
+        }
+    }
+
+    void rethrowIfThrown() {
+        if (exception) std::rethrow_exception(exception);
+    }
+};
+
 }  // namespace
 
 namespace internal {
@@ -1117,6 +1724,142 @@ const OBX_id_array cIdArrayRef(const std::vector<obx_id>& ids);
 /// Note: even if this function throws the given OBX_id_array is freed.
 std::vector<obx_id> idVectorOrThrow(OBX_id_array* cIds);
 
+/// Produces the indices of the given ids ordered by ascending ID (stable, i.e. duplicates keep their order).
+/// Accessing IDs in this order walks the database sequentially instead of "jumping around".
+std::vector<size_t> idOrderAscending(const std::vector<obx_id>& ids);
+
+/// Intersects the sorted IDs in inOut with the given IDs (sorted here if needed); the result stays sorted.
+/// If one side is much smaller, its IDs are looked up in the other side (binary search) instead of a full merge.
+void intersectIds(std::vector<obx_id>& inOut, std::vector<obx_id>& ids);
+
+/// Worker threads reused by parallelChunks(); started on demand and kept until the process exits, so per-call costs
+/// are limited to handing over tasks (instead of starting threads for each call).
+class ChunkWorkers {
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> threads_;
+    bool stopping_ = false;
+
+public:
+    /// The process-wide instance; thread-safe.
+    static ChunkWorkers& instance();
+
+    ~ChunkWorkers();
+
+    /// Queues a task for the workers, starting workers until there are at least the given number (max. 64).
+    /// @returns false if there is no worker to run the task (e.g. a thread could not be started)
+    bool submit(std::function<void()> task, size_t minWorkers);
+
+private:
+    void run();
+};
+
+/// Calls fn(begin, end) for consecutive chunks of the range [0, count) using up to threadCount threads: the calling
+/// thread and reused worker threads (ChunkWorkers) take chunks until all are taken. Thus, fn must not assume to run on
+/// the calling thread. Returns once all chunks are processed; the first exception thrown by fn (in chunk order) is
+/// re-thrown on the calling thread.
+template <typename Fn>
+void parallelChunks(size_t count, size_t threadCount, Fn fn) {
+    if (threadCount > count) threadCount = count;
+    if (threadCount <= 1) {
+        if (count > 0) fn(size_t(0), count);
+        return;
+    }
+
+    // Shared with the queued tasks, which may only run after this call returned (all chunks were taken meanwhile)
+    struct Chunks {
+        size_t count;
+        size_t size;
+        size_t total;
+        std::atomic<size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable finishedCondition;
+        size_t finished = 0;  ///< Guarded by mutex
+        std::vector<std::exception_ptr> exceptions;
+    };
+    std::shared_ptr<Chunks> chunks = std::make_shared<Chunks>();
+    chunks->count = count;
+    chunks->size = (count + threadCount - 1) / threadCount;
+    chunks->total = (count + chunks->size - 1) / chunks->size;
+    chunks->exceptions.resize(chunks->total);
+
+    Fn* fnPtr = &fn;  // Only dereferenced for a taken chunk, i.e. while this call waits for it
+    auto takeChunks = [chunks, fnPtr]() {
+        size_t chunk;
+        while ((chunk = chunks->next.fetch_add(1)) < chunks->total) {
+            size_t begin = chunk * chunks->size;
+            try {
+                (*fnPtr)(begin, std::min(chunks->count, begin + chunks->size));
+            } catch (...) {
+                chunks->exceptions[chunk] = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(chunks->mutex);
+            if (++chunks->finished == chunks->total) chunks->finishedCondition.notify_all();
+        }
+    };
+
+    ChunkWorkers& workers = ChunkWorkers::instance();
+    for (size_t i = 1; i < chunks->total; i++) {
+        if (!workers.submit(takeChunks, threadCount - 1)) break;  // The calling thread takes the remaining chunks
+    }
+    takeChunks();
+    {
+        std::unique_lock<std::mutex> lock(chunks->mutex);
+        chunks->finishedCondition.wait(lock, [&chunks]() { return chunks->finished == chunks->total; });
+    }
+    for (std::exception_ptr& exception : chunks->exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
+
+#ifdef OBX_CPP_FILE
+ChunkWorkers& ChunkWorkers::instance() {
+    static ChunkWorkers workers;
+    return workers;
+}
+
+ChunkWorkers::~ChunkWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread& thread : threads_) thread.join();
+}
+
+bool ChunkWorkers::submit(std::function<void()> task, size_t minWorkers) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        minWorkers = std::min(minWorkers, size_t(64));
+        while (threads_.size() < minWorkers) {
+            try {
+                threads_.emplace_back(&ChunkWorkers::run, this);
+            } catch (const std::system_error&) {  // Could not start a thread (resources); continue with what we have
+                break;
+            }
+        }
+        if (threads_.empty()) return false;
+        tasks_.push_back(std::move(task));
+    }
+    condition_.notify_one();
+    return true;
+}
+
+void ChunkWorkers::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) return;  // Stopping
+        std::function<void()> task = std::move(tasks_.front());
+        tasks_.pop_front();
+        lock.unlock();
+        task();  // Does not throw: exceptions of the chunks are kept for the caller
+        lock.lock();
+    }
+}
+#endif  // OBX_CPP_FILE
+
 #ifdef OBX_CPP_FILE
 const OBX_id_array cIdArrayRef(const std::vector<obx_id>& ids) {
     // Note: removing const from ids.data() to match the C struct, but returning struct as const; so it should be OK:
@@ -1141,6 +1884,34 @@ std::vector<obx_id> idVectorOrThrow(OBX_id_array* cIds) {
         throw;
     }
 }
+
+std::vector<size_t> idOrderAscending(const std::vector<obx_id>& ids) {
+    std::vector<size_t> order(ids.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    if (!std::is_sorted(ids.begin(), ids.end())) {
+        std::stable_sort(order.begin(), order.end(), [&ids](size_t a, size_t b) { return ids[a] < ids[b]; });
+    }
+    return order;
+}
+
+void intersectIds(std::vector<obx_id>& inOut, std::vector<obx_id>& ids) {
+    if (!std::is_sorted(ids.begin(), ids.end())) std::sort(ids.begin(), ids.end());
+    const std::vector<obx_id>& small = inOut.size() <= ids.size() ? inOut : ids;
+    const std::vector<obx_id>& large = inOut.size() <= ids.size() ? ids : inOut;
+    std::vector<obx_id> result;
+    result.reserve(small.size());
+    if (small.size() * 32 < large.size()) {  // Skewed sizes: search from the last position on (IDs are ascending)
+        std::vector<obx_id>::const_iterator position = large.begin();
+        for (obx_id id : small) {
+            position = std::lower_bound(position, large.end(), id);
+            if (position == large.end()) break;
+            if (*position == id) result.push_back(id);
+        }
+    } else {
+        std::set_intersection(small.begin(), small.end(), large.begin(), large.end(), std::back_inserter(result));
+    }
+    inOut.swap(result);
+}
 #endif
 
 }  // namespace internal
@@ -2163,12 +2934,76 @@ protected:
     }
 };
 
+/// Cumulative execution statistics of a single query object; see QueryBase::stats().
+struct QueryStats {
+    uint64_t executions = 0;   ///< Number of executions, e.g. calls to find() or count()
+    uint64_t totalMicros = 0;  ///< Total execution time
+    uint64_t maxMicros = 0;    ///< Slowest execution
+    uint64_t resultCount = 0;  ///< Total objects (or IDs) returned, counted or removed; visitor methods do not count
+
+    double meanMicros() const { return executions ? static_cast<double>(totalMicros) / executions : 0.0; }
+};
+
+namespace internal {
+
+/// Times a query execution if the store's metrics are enabled; once it goes out of scope, it updates the query's stats
+/// and the store's metrics, which may report it as a slow query. Without metrics, it does not even read the clock.
+class QueryTimer {
+    OBX_query* cQuery_;
+    QueryStats& stats_;
+    StoreMetrics* metrics_;
+    const char* operation_;
+    uint64_t resultCount_ = 0;
+    std::chrono::steady_clock::time_point begin_;
+
+public:
+    QueryTimer(const Store& store, OBX_query* cQuery, QueryStats& stats, const char* operation)
+        : cQuery_(cQuery), stats_(stats), metrics_(store.metrics()), operation_(operation) {
+        if (metrics_) begin_ = std::chrono::steady_clock::now();
+    }
+
+    QueryTimer(const QueryTimer&) = delete;
+
+    ~QueryTimer() {
+        if (!metrics_) return;
+        std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - begin_;
+        std::chrono::microseconds micros = std::chrono::duration_cast<std::chrono::microseconds>(duration);
+        stats_.executions++;
+        stats_.totalMicros += static_cast<uint64_t>(micros.count());
+        stats_.maxMicros = std::max(stats_.maxMicros, static_cast<uint64_t>(micros.count()));
+        stats_.resultCount += resultCount_;
+        if (metrics_->recordQuery(duration)) {
+            try {  // Do not throw from the destructor; e.g. the callback failing must not affect the query
+                const char* description = obx_query_describe_params(cQuery_);
+                metrics_->reportSlowQuery({operation_, description ? description : "", micros, resultCount_});
+            } catch (...) {
+            }
+        }
+    }
+
+    /// Sets the result count (for the query stats) and passes the count through.
+    uint64_t counted(uint64_t count) {
+        resultCount_ = count;
+        return count;
+    }
+
+    /// Sets the number of results (for the query stats) and passes the results through.
+    template <typename Results>
+    Results counted(Results results) {
+        resultCount_ = results.size();
+        return results;
+    }
+};
+
+}  // namespace internal
+
 /// Query allows to find data matching user defined criteria for a entity type.
 /// Created by QueryBuilder and typically used with supplying a Cursor.
 class QueryBase {
 protected:
     Store& store_;
     OBX_query* cQuery_;
+    QueryStats stats_;
 
 public:
     /// Builds a query with the parameters specified by the builder
@@ -2181,7 +3016,7 @@ public:
         internal::checkPtrOrThrow(cQuery_, "Can not clone query");
     }
 
-    QueryBase(QueryBase&& source) noexcept : store_(source.store_), cQuery_(source.cQuery_) {
+    QueryBase(QueryBase&& source) noexcept : store_(source.store_), cQuery_(source.cQuery_), stats_(source.stats_) {
         source.cQuery_ = nullptr;
     }
 
@@ -2189,11 +3024,30 @@ public:
 
     OBX_query* cPtr() const { return cQuery_; }
 
-    /// Sets an offset of what items to start at.
-    /// This offset is stored for any further calls on the query until changed.
-    /// Call with offset=0 to reset to the default behavior, i.e. starting from the first element.
-    QueryBase& offset(size_t offset) {
-        internal::checkErrOrThrow(obx_query_offset(cQuery_, offset));
+    /// Execution statistics of this query object (a clone starts with empty statistics); only executions while the
+    /// store's metrics are enabled (see Store::enableMetrics()) are recorded.
+    /// Like the query itself, this is not thread-safe; i.e. poll it on the thread using this query.
+    /// To get notified about individual slow executions across all queries, see StoreMetrics::onSlowQuery().
+    const QueryStats& stats() const { return stats_; }
+
+    /// Describes the query conditions, e.g. for debugging.
+    std::string describe() const {
+        OBX_VERIFY_STATE(cQuery_);
+        return std::string(internal::checkedPtrOrThrow(obx_query_describe(cQuery_), "Can not describe query"));
+    }
+
+    /// Describes the query conditions including their current parameter values, e.g. for debugging.
+    std::string describeParameters() const {
+        OBX_VERIFY_STATE(cQuery_);
+        const char* description = obx_query_describe_params(cQuery_);
+        return std::string(internal::checkedPtrOrThrow(description, "Can not describe query parameters"));
+    }
+
+    /// Sets an offset of what items to start at.
+    /// This offset is stored for any further calls on the query until changed.
+    /// Call with offset=0 to reset to the default behavior, i.e. starting from the first element.
+    QueryBase& offset(size_t offset) {
+        internal::checkErrOrThrow(obx_query_offset(cQuery_, offset));
         return *this;
     }
 
@@ -2208,12 +3062,16 @@ public:
     /// Returns IDs of all matching objects.
     /// Note: if no order conditions is present, the order is arbitrary
     ///       (sometimes ordered by ID, but never guaranteed to).
-    std::vector<obx_id> findIds() { return internal::idVectorOrThrow(obx_query_find_ids(cQuery_)); }
+    std::vector<obx_id> findIds() {
+        internal::QueryTimer timer(store_, cQuery_, stats_, "findIds");
+        return timer.counted(internal::idVectorOrThrow(obx_query_find_ids(cQuery_)));
+    }
 
     /// Find object IDs matching the query associated to their query score (e.g. distance in NN search).
     /// The resulting vector is sorted by score in ascending order (unlike findIds()).
     std::vector<std::pair<obx_id, double>> findIdsWithScores() {
         OBX_VERIFY_STATE(cQuery_);
+        internal::QueryTimer timer(store_, cQuery_, stats_, "findIdsWithScores");
 
         OBX_id_score_array* cResult = obx_query_find_ids_with_scores(cQuery_);
         if (!cResult) internal::throwLastError();
@@ -2228,19 +3086,23 @@ public:
 
         obx_id_score_array_free(cResult);
 
-        return result;
+        return timer.counted(std::move(result));
     }
 
     /// Find object IDs matching the query ordered by their query score (e.g. distance in NN search).
     /// The resulting array is sorted by score in ascending order (unlike findIds()).
     /// Unlike findIdsWithScores(), this method returns a simple vector of IDs without scores.
-    std::vector<obx_id> findIdsByScore() { return internal::idVectorOrThrow(obx_query_find_ids_by_score(cQuery_)); }
+    std::vector<obx_id> findIdsByScore() {
+        internal::QueryTimer timer(store_, cQuery_, stats_, "findIdsByScore");
+        return timer.counted(internal::idVectorOrThrow(obx_query_find_ids_by_score(cQuery_)));
+    }
 
     /// Walk over matching objects one-by-one using the given data visitor (C-style callback function with user data).
     /// Note: if no order conditions is present, the order is arbitrary (sometimes ordered by ID, but never guaranteed
     /// to).
     void visit(obx_data_visitor* visitor, void* userData) {
         OBX_VERIFY_STATE(cQuery_);
+        internal::QueryTimer timer(store_, cQuery_, stats_, "visit");
         obx_err err = obx_query_visit(cQuery_, visitor, userData);
         internal::checkErrOrThrow(err);
     }
@@ -2249,22 +3111,26 @@ public:
     /// Note: the elements are ordered by the score.
     void visitWithScore(obx_data_score_visitor* visitor, void* userData) {
         OBX_VERIFY_STATE(cQuery_);
+        internal::QueryTimer timer(store_, cQuery_, stats_, "visitWithScore");
         obx_err err = obx_query_visit_with_score(cQuery_, visitor, userData);
         internal::checkErrOrThrow(err);
     }
 
     /// Returns the number of matching objects.
     uint64_t count() {
+        internal::QueryTimer timer(store_, cQuery_, stats_, "count");
         uint64_t result;
         internal::checkErrOrThrow(obx_query_count(cQuery_, &result));
-        return result;
+        return timer.counted(result);
     }
 
     /// Removes all matching objects from the database & returns the number of deleted objects.
     size_t remove() {
+        internal::QueryTimer timer(store_, cQuery_, stats_, "remove");
         uint64_t result;
         internal::checkErrOrThrow(obx_query_remove(cQuery_, &result));
-        return result;
+        if (result) store_.invalidateObjectCaches();  // The query's entity type is not known here
+        return timer.counted(result);
     }
 
     /// Change previously set condition value in an existing query - this improves reusability of the query object.
@@ -2283,10 +3149,135 @@ public:
     }
 };
 
+/// Results of multiple searches in a flat layout, e.g. from Query::findIdsWithScoresBatch().
+/// The results of search i are idsWithScores[offsets[i]] up to (excluding) idsWithScores[offsets[i + 1]].
+struct IdScoreBatch {
+    std::vector<std::pair<obx_id, double>> idsWithScores;
+    std::vector<size_t> offsets;  ///< One entry per search plus a final entry (the total result count)
+
+    /// The number of searches
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    /// The number of results of the given search
+    size_t count(size_t search) const { return offsets[search + 1] - offsets[search]; }
+
+    /// The first result of the given search; use with count()
+    const std::pair<obx_id, double>* results(size_t search) const { return idsWithScores.data() + offsets[search]; }
+};
+
+/// \brief Reads the results of a query in batches of objects; see Query::stream().
+///
+/// All batches are read from a single read transaction (a consistent snapshot) that is held until the stream is
+/// destroyed. Peak memory usage is bounded by the batch size (plus the IDs of the matching objects), which is typically
+/// much less than having all resulting objects in memory at once.
+/// As a stream holds a read transaction, it is bound to the thread it was created on; do not keep it longer than
+/// needed.
+///
+/// **Example:**
+///
+///          for (std::vector<Task>& batch : query.stream(1000)) {
+///              exportTasks(batch);
+///          }
+template <typename EntityT>
+class QueryStream {
+    Transaction tx_;
+    OBX_cursor* cCursor_;
+    std::vector<obx_id> ids_;  ///< All matching IDs in result order (but no objects yet)
+    size_t position_ = 0;      ///< Index into ids_ of the next object to read
+    const size_t batchSize_;
+    std::vector<EntityT> batch_;  ///< Used by the iterator; reused across batches
+
+public:
+    /// Input iterator over batches; a batch is only valid until the iterator is incremented.
+    class Iterator {
+        QueryStream* stream_;  ///< nullptr for the end iterator
+
+    public:
+        explicit Iterator(QueryStream* stream) : stream_(stream) {
+            if (stream_ && !stream_->nextBatch(stream_->batch_)) stream_ = nullptr;
+        }
+
+        std::vector<EntityT>& operator*() const { return stream_->batch_; }
+
+        Iterator& operator++() {
+            if (!stream_->nextBatch(stream_->batch_)) stream_ = nullptr;
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return stream_ == other.stream_; }
+        bool operator!=(const Iterator& other) const { return stream_ != other.stream_; }
+    };
+
+    QueryStream(Store& store, OBX_query* cQuery, size_t batchSize)
+        : tx_(store, TxMode::READ),
+          cCursor_(obx_cursor(tx_.cPtr(), EntityT::_OBX_MetaInfo::entityId())),
+          batchSize_(batchSize) {
+        internal::checkPtrOrThrow(cCursor_, "Can not open cursor");
+        try {
+            OBX_VERIFY_ARGUMENT(batchSize_ > 0);
+            ids_ = internal::idVectorOrThrow(obx_query_cursor_find_ids(cQuery, cCursor_));
+        } catch (...) {
+            obx_cursor_close(cCursor_);
+            throw;
+        }
+    }
+
+    /// Can't be copied, single owner of C resources is required (to avoid double-free during destruction)
+    QueryStream(const QueryStream&) = delete;
+
+    QueryStream(QueryStream&& source) noexcept
+        : tx_(std::move(source.tx_)),
+          cCursor_(source.cCursor_),
+          ids_(std::move(source.ids_)),
+          position_(source.position_),
+          batchSize_(source.batchSize_),
+          batch_(std::move(source.batch_)) {
+        source.cCursor_ = nullptr;
+    }
+
+    ~QueryStream() { obx_cursor_close(cCursor_); }
+
+    /// The total number of objects matching the query (i.e. the sum of all batch sizes).
+    size_t size() const { return ids_.size(); }
+
+    /// @returns true if there are IDs left to read; nextBatch() may still return false if none of them is found.
+    bool hasNext() const { return position_ < ids_.size(); }
+
+    /// Reads the next batch of objects into the given vector, replacing its previous content.
+    /// Existing objects in the vector are reused to avoid allocations, so passing the same vector each time is
+    /// encouraged.
+    /// @returns false if there were no objects left (outBatch is empty in that case); a returned batch is never empty
+    bool nextBatch(std::vector<EntityT>& outBatch) {
+        OBX_VERIFY_STATE(cCursor_);
+        size_t count = 0;
+        const void* data;
+        size_t size;
+        while (count == 0 && hasNext()) {  // Objects not found are skipped; continue until the batch has objects
+            size_t end = std::min(ids_.size(), position_ + batchSize_);
+            outBatch.resize(end - position_);
+            for (; position_ < end; position_++) {
+                obx_err err = obx_cursor_get(cCursor_, ids_[position_], &data, &size);
+                if (err == OBX_NOT_FOUND) continue;  // Not expected in the same TX; be lenient anyway
+                internal::checkErrOrThrow(err);
+                EntityT::_OBX_MetaInfo::fromFlatBuffer(data, size, outBatch[count++]);
+            }
+        }
+        outBatch.resize(count);
+        return count > 0;
+    }
+
+    /// Reads the first batch; to be used with range-based for loops (see class docs).
+    Iterator begin() { return Iterator(this); }
+
+    Iterator end() { return Iterator(nullptr); }
+};
+
 /// Query allows to find data matching user defined criteria for a entity type.
 /// Created by QueryBuilder and typically used with supplying a Cursor.
 template <typename EntityT>
 class Query : public QueryBase {
+    size_t parallelism_ = 1;
+
 public:
     using QueryBase::QueryBase;
 
@@ -2306,30 +3297,88 @@ public:
         return *this;
     }
 
+    /// Opt-in to read the objects found by find() and findUniquePtrs() using multiple threads.
+    /// Matching objects are still found on the calling thread; the threads then read (deserialize) the objects
+    /// from the same read transaction, i.e. the same consistent snapshot of the data.
+    /// This pays off for large results, where reading objects dominates (e.g. with many strings or vectors).
+    /// The order of the results stays the same, e.g. as defined by order conditions.
+    /// @param threadCount the number of threads (including the calling thread); 0 or 1 (default) disables threading.
+    Query& parallelism(size_t threadCount) {
+        parallelism_ = threadCount;
+        return *this;
+    }
+
     /// Finds all objects matching the query.
     /// @return a vector of objects
     std::vector<EntityT> find() {
         OBX_VERIFY_STATE(cQuery_);
+        internal::QueryTimer timer(store_, cQuery_, stats_, "find");
+        if (parallelism_ > 1) return timer.counted(findParallel<EntityT>());
 
         CollectingVisitor<EntityT> visitor;
         obx_query_visit(cQuery_, CollectingVisitor<EntityT>::visit, &visitor);
-        return std::move(visitor.items);
+        return timer.counted(std::move(visitor.items));
     }
 
     /// Finds all objects matching the query.
     /// @return a vector of unique_ptr of the resulting objects
     std::vector<std::unique_ptr<EntityT>> findUniquePtrs() {
         OBX_VERIFY_STATE(cQuery_);
+        internal::QueryTimer timer(store_, cQuery_, stats_, "findUniquePtrs");
+        if (parallelism_ > 1) return timer.counted(findParallel<std::unique_ptr<EntityT>>());
 
         CollectingVisitorUniquePtr<EntityT> visitor;
         obx_query_visit(cQuery_, CollectingVisitorUniquePtr<EntityT>::visit, &visitor);
-        return std::move(visitor.items);
+        return timer.counted(std::move(visitor.items));
+    }
+
+    /// Finds all objects matching the query as zero-copy views (no objects are read, i.e. no per-object allocation).
+    /// @param tx an active transaction of this query's store, which must be kept active as long as the views are used;
+    ///        i.e. the views are only valid until the transaction ends or a write operation is executed.
+    /// @return a vector of views; see EntityViewType for the actual type (e.g. a generated view type)
+    std::vector<typename EntityViewType<EntityT>::type> findViews(Transaction& tx) {
+        OBX_VERIFY_STATE(cQuery_);
+        OBX_VERIFY_ARGUMENT(tx.isActive());
+        OBX_VERIFY_ARGUMENT(tx.isForStore(store_));
+        internal::QueryTimer timer(store_, cQuery_, stats_, "findViews");
+
+        using ViewT = typename EntityViewType<EntityT>::type;
+        CollectingViewVisitor<ViewT> visitor;
+        internal::checkErrOrThrow(obx_query_visit(cQuery_, CollectingViewVisitor<ViewT>::visit, &visitor));
+        return timer.counted(std::move(visitor.items));
+    }
+
+    /// Walks over matching objects one-by-one as zero-copy views (no objects are read, i.e. no per-object allocation).
+    /// Unless called inside an outer transaction, a view is only valid until the given visitor returns.
+    /// @param visitor a callable taking a view (see EntityViewType), e.g. const ObjectView<EntityT>&, and returning
+    ///        true to continue visiting or false to stop.
+    /// An exception thrown by the visitor stops visiting and is propagated unchanged (like Box::forEachView()).
+    template <typename Visitor>
+    void forEachView(Visitor visitor) {
+        OBX_VERIFY_STATE(cQuery_);
+        internal::QueryTimer timer(store_, cQuery_, stats_, "forEachView");
+
+        using ViewT = typename EntityViewType<EntityT>::type;
+        ForwardingViewVisitor<ViewT, Visitor> forwarder(visitor);
+        obx_err err = obx_query_visit(cQuery_, ForwardingViewVisitor<ViewT, Visitor>::visit, &forwarder);
+        forwarder.rethrowIfThrown();
+        internal::checkErrOrThrow(err);
+    }
+
+    /// Streams the objects matching the query in batches of the given size, which bounds memory usage for large
+    /// results (unlike find()). Unlike paging with offset/limit, the query is executed only once.
+    /// See QueryStream for details, e.g. it holds a read transaction until it is destroyed.
+    /// @param batchSize the maximum number of objects per batch (non-zero)
+    QueryStream<EntityT> stream(size_t batchSize) {
+        OBX_VERIFY_STATE(cQuery_);
+        return QueryStream<EntityT>(store_, cQuery_, batchSize);
     }
 
     /// Find objects matching the query associated to their query score (e.g. distance in NN search).
     /// The resulting vector is sorted by score in ascending order (unlike find()).
     std::vector<std::pair<EntityT, double>> findWithScores() {
         OBX_VERIFY_STATE(cQuery_);
+        internal::QueryTimer timer(store_, cQuery_, stats_, "findWithScores");
 
         OBX_bytes_score_array* cResult = obx_query_find_with_scores(cQuery_);
 
@@ -2343,7 +3392,7 @@ public:
 
         obx_bytes_score_array_free(cResult);
 
-        return result;
+        return timer.counted(std::move(result));
     }
 
     /// Find the first object matching the query or nullptr if none matches.
@@ -2513,16 +3562,116 @@ public:
         return *this;
     }
 
+    /// Runs this nearest neighbor query once per given query vector, i.e. many vector searches in one call.
+    /// The searches of each thread share a single read transaction. If parallelism() is set, the query vectors are
+    /// split across threads, each using its own clone of this query and its own read transaction. Thus, with
+    /// concurrent writes, the query vectors of different threads may be searched in different database snapshots;
+    /// use a single thread (the default) if all results must reflect the same snapshot.
+    /// The statistics of the clones are added to this query's stats().
+    /// Note: the vector parameter of this query is left set to one of the given query vectors.
+    /// @param queryVectors queryCount vectors of elementCount values each, stored one after another
+    /// @returns the IDs with scores (nearest first) for all query vectors in the order of the query vectors
+    template <typename PropertyEntityT>
+    IdScoreBatch findIdsWithScoresBatch(Property<PropertyEntityT, OBXPropertyType_FloatVector> property,
+                                        const float* queryVectors, size_t queryCount, size_t elementCount) {
+        OBX_VERIFY_STATE(cQuery_);
+        std::vector<std::vector<std::pair<obx_id, double>>> perQuery(queryCount);
+
+        // Queries are not thread-safe: clone upfront, so each thread takes its own query (this one or a clone)
+        size_t threadCount = std::min(std::max(parallelism_, size_t(1)), queryCount);
+        std::vector<std::unique_ptr<Query>> clones;
+        for (size_t i = 1; i < threadCount; i++) clones.emplace_back(new Query(*this));
+        std::mutex queriesMutex;
+        std::vector<Query*> queries{this};
+        for (std::unique_ptr<Query>& clone : clones) queries.push_back(clone.get());
+
+        // There are at most threadCount chunks, so each chunk takes a query of its own
+        internal::parallelChunks(queryCount, threadCount, [&](size_t begin, size_t end) {
+            Query* taken;
+            {
+                std::lock_guard<std::mutex> lock(queriesMutex);
+                taken = queries.back();
+                queries.pop_back();
+            }
+            Query& query = *taken;
+            Transaction tx = store_.txRead();
+            for (size_t i = begin; i < end; i++) {
+                query.setParameter(property, queryVectors + i * elementCount, elementCount);
+                perQuery[i] = query.findIdsWithScores();
+            }
+        });
+        for (std::unique_ptr<Query>& clone : clones) {
+            const QueryStats& cloneStats = clone->stats();
+            stats_.executions += cloneStats.executions;
+            stats_.totalMicros += cloneStats.totalMicros;
+            stats_.maxMicros = std::max(stats_.maxMicros, cloneStats.maxMicros);
+            stats_.resultCount += cloneStats.resultCount;
+        }
+
+        IdScoreBatch result;
+        result.offsets.reserve(queryCount + 1);
+        result.offsets.push_back(0);
+        for (const std::vector<std::pair<obx_id, double>>& results : perQuery) {
+            result.offsets.push_back(result.offsets.back() + results.size());
+        }
+        result.idsWithScores.reserve(result.offsets.back());
+        for (const std::vector<std::pair<obx_id, double>>& results : perQuery) {
+            result.idsWithScores.insert(result.idsWithScores.end(), results.begin(), results.end());
+        }
+        return result;
+    }
+
+    /// Overload for query vectors given as a vector of vectors; all must have the same element count.
+    template <typename PropertyEntityT>
+    IdScoreBatch findIdsWithScoresBatch(Property<PropertyEntityT, OBXPropertyType_FloatVector> property,
+                                        const std::vector<std::vector<float>>& queryVectors) {
+        std::vector<float> flat;
+        size_t elementCount = queryVectors.empty() ? 0 : queryVectors[0].size();
+        flat.reserve(queryVectors.size() * elementCount);
+        for (const std::vector<float>& vector : queryVectors) {
+            if (vector.size() != elementCount) {
+                throw IllegalArgumentException("All query vectors must have the same element count");
+            }
+            flat.insert(flat.end(), vector.begin(), vector.end());
+        }
+        return findIdsWithScoresBatch(property, flat.data(), queryVectors.size(), elementCount);
+    }
+
 private:
+    template <typename Item>
+    std::vector<Item> findParallel() {
+        Transaction tx = store_.txRead();  // Keeps the data valid for all threads until the objects are read
+
+        using Visitor = CollectingViewVisitor<ObjectView<EntityT>>;
+        Visitor visitor;
+        internal::checkErrOrThrow(obx_query_visit(cQuery_, Visitor::visit, &visitor));
+        const std::vector<ObjectView<EntityT>>& views = visitor.items;
+
+        std::vector<Item> result(views.size());
+        internal::parallelChunks(views.size(), parallelism_, [&views, &result](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) readFromView(views[i], result[i]);
+        });
+        return result;
+    }
+
+    static void readFromView(const ObjectView<EntityT>& view, EntityT& outObject) { view.toObject(outObject); }
+
+    static void readFromView(const ObjectView<EntityT>& view, std::unique_ptr<EntityT>& outObject) {
+        outObject = EntityT::_OBX_MetaInfo::newFromFlatBuffer(view.data(), view.size());
+    }
+
     template <typename RET, typename T>
     RET findSingle(obx_err nativeFn(OBX_query*, const void**, size_t*), T fromFlatBuffer(const void*, size_t)) {
         OBX_VERIFY_STATE(cQuery_);
+        const char* operation = nativeFn == obx_query_find_unique ? "findUnique" : "findFirst";
+        internal::QueryTimer timer(store_, cQuery_, stats_, operation);
         Transaction tx = store_.txRead();
         const void* data;
         size_t size;
         obx_err err = nativeFn(cQuery_, &data, &size);
         if (err == OBX_NOT_FOUND) return RET();
         internal::checkErrOrThrow(err);
+        timer.counted(uint64_t(1));
         return fromFlatBuffer(data, size);
     }
 };
@@ -2564,6 +3713,12 @@ void inline threadLocalFbbDone() {
 }  // namespace internal
 #endif
 
+/// Location of an object's bytes inside an arena (a contiguous buffer), e.g. filled by BoxTypeless::getManyInto().
+struct ArenaRange {
+    size_t offset;  ///< Start of the object's bytes, relative to the arena's start
+    size_t size;    ///< Size of the object's bytes; zero if the object was not found
+};
+
 /// Like Box, but without template type.
 /// Serves as the basis for Box, but can also be used as "lower-level" box with some restrictions on the functionality.
 class BoxTypeless {
@@ -2571,18 +3726,45 @@ protected:
     Store& store_;
     OBX_box* cBox_;
     const obx_schema_id entityTypeId_;
+    StoreMetrics::EntityCounters* entityMetrics_;  ///< Null unless the store had metrics enabled at construction
+    /// Null unless the entity type had a cache at construction or enableObjectCache() was called on this box
+    std::atomic<ObjectCache*> objectCache_;
 
 public:
     BoxTypeless(Store& store, obx_schema_id entityTypeId)
-        : store_(store), cBox_(obx_box(store.cPtr(), entityTypeId)), entityTypeId_(entityTypeId) {
+        : store_(store),
+          cBox_(obx_box(store.cPtr(), entityTypeId)),
+          entityTypeId_(entityTypeId),
+          entityMetrics_(store.metrics() ? &store.metrics()->entity(entityTypeId) : nullptr),
+          objectCache_(store.objectCache(entityTypeId)) {
         if (cBox_ == nullptr) {
             std::string msg = "Can not create box for entity type ID " + std::to_string(entityTypeId_);
             internal::checkPtrOrThrow(cBox_, msg.c_str());
         }
     }
 
+    BoxTypeless(const BoxTypeless& source)
+        : store_(source.store_),
+          cBox_(source.cBox_),
+          entityTypeId_(source.entityTypeId_),
+          entityMetrics_(source.entityMetrics_),
+          objectCache_(source.objectCache_.load(std::memory_order_acquire)) {}
+
     OBX_box* cPtr() const { return cBox_; }
 
+    /// Enables caching objects of this box's entity type; see Store::enableObjectCache() for details.
+    /// Note: other Box objects of this type use the cache if created afterwards.
+    /// May be called while other threads read via this box; these use the cache once they see it.
+    /// @param capacity the maximum number of cached objects; ignored if the cache was already enabled
+    ObjectCache& enableObjectCache(size_t capacity) {
+        ObjectCache& cache = store_.enableObjectCache(entityTypeId_, capacity);
+        objectCache_.store(&cache, std::memory_order_release);
+        return cache;
+    }
+
+    /// @returns the object cache used by this box, or nullptr if none
+    ObjectCache* objectCache() const { return objectCache_.load(std::memory_order_acquire); }
+
     /// Return the number of objects contained by this box.
     /// @param limit if provided: stop counting at the given limit - useful if you need to make sure the Box has "at
     /// least" this many objects but you don't need to know the exact number.
@@ -2622,9 +3804,51 @@ public:
         obx_err err = obx_cursor_get(cTx.cPtr(), id, data, size);
         if (err == OBX_NOT_FOUND) return false;
         internal::checkErrOrThrow(err);
+        if (entityMetrics_) entityMetrics_->addGets(1);
+        return true;
+    }
+
+    /// Low-level API: reads an object as FlatBuffers bytes using the object cache (if enabled) outside of transactions;
+    /// otherwise (or on a cache miss) from the database.
+    /// @param reader called with the data and size of the object if found; the data is only valid during the call
+    /// @return true on success, false if the ID was not found
+    template <typename Reader>
+    bool getCached(obx_id id, Reader reader) {
+        ObjectCache* cache = objectCache();
+        if (cache && Transaction::threadDepth(store_.cPtr()) == 0) {
+            std::shared_ptr<const ObjectCache::Entry> entry = cache->find(id);
+            if (entry) {
+                if (entityMetrics_) entityMetrics_->addGets(1);
+                reader(entry->data.data(), entry->data.size());
+                return true;
+            }
+            uint64_t version = cache->version();  // Before the TX begins; the version may only advance
+            CursorTx ctx(TxMode::READ, store_, entityTypeId_);
+            const void* data;
+            size_t size;
+            if (!get(ctx, id, &data, &size)) return false;
+            cache->put(id, version, data, size);
+            reader(data, size);
+            return true;
+        }
+        CursorTx ctx(TxMode::READ, store_, entityTypeId_);
+        const void* data;
+        size_t size;
+        if (!get(ctx, id, &data, &size)) return false;
+        reader(data, size);
         return true;
     }
 
+    /// Low-level API: reads multiple objects as FlatBuffers bytes into a single contiguous arena in one read TX.
+    /// Compared to reading objects one-by-one, this avoids per-object allocations: the arena is resized only once.
+    /// Also, objects are looked up in ascending ID order to traverse the database sequentially.
+    /// Each object starts at an 8-byte aligned offset, so the FlatBuffers can be accessed directly in the arena.
+    /// @param arena receives the bytes of all found objects; any previous content is replaced.
+    /// @param outRanges receives the location of each object in the arena; index-matches the given ids.
+    ///        For IDs that were not found, the size is zero.
+    /// @returns the number of objects found
+    size_t getManyInto(const std::vector<obx_id>& ids, std::vector<uint8_t>& arena, std::vector<ArenaRange>& outRanges);
+
     /// Low-level API: puts the given FlatBuffers object.
     /// @returns the ID of the put object or 0 if the operation failed (no exception is thrown).
     obx_id putNoThrow(void* data, size_t size, OBXPutMode mode = OBXPutMode_PUT);
@@ -2642,6 +3866,15 @@ public:
     /// Removes all objects from the box
     /// @returns the number of removed objects
     uint64_t removeAll();
+
+protected:
+    /// Called after a write: outside of a transaction, it was committed already, so the object cache of this type (if
+    /// any) must be invalidated. Within a transaction, this is redundant as the commit invalidates the caches again.
+    void invalidateObjectCache() {
+        ObjectCache* cache = objectCache();
+        if (!cache) cache = store_.objectCache(entityTypeId_);
+        if (cache) cache->invalidate();
+    }
 };
 
 #ifdef OBX_CPP_FILE
@@ -2649,7 +3882,12 @@ public:
 BoxTypeless Store::boxTypeless(const char* entityName) { return BoxTypeless(*this, getEntityTypeId(entityName)); }
 
 obx_id BoxTypeless::putNoThrow(void* data, size_t size, OBXPutMode mode) {
-    return obx_box_put_object4(cBox_, data, size, mode);
+    obx_id id = obx_box_put_object4(cBox_, data, size, mode);
+    if (id) {
+        if (entityMetrics_) entityMetrics_->addPuts(1);
+        invalidateObjectCache();
+    }
+    return id;
 }
 
 obx_id BoxTypeless::put(void* data, size_t size, OBXPutMode mode) {
@@ -2662,6 +3900,7 @@ bool BoxTypeless::remove(obx_id id) {
     obx_err err = obx_box_remove(cBox_, id);
     if (err == OBX_NOT_FOUND) return false;
     internal::checkErrOrThrow(err);
+    invalidateObjectCache();
     return true;
 }
 
@@ -2669,15 +3908,48 @@ uint64_t BoxTypeless::remove(const std::vector<obx_id>& ids) {
     uint64_t result = 0;
     const OBX_id_array cIds = internal::cIdArrayRef(ids);
     internal::checkErrOrThrow(obx_box_remove_many(cBox_, &cIds, &result));
+    if (result) invalidateObjectCache();
     return result;
 }
 
 uint64_t BoxTypeless::removeAll() {
     uint64_t result = 0;
     internal::checkErrOrThrow(obx_box_remove_all(cBox_, &result));
+    if (result) invalidateObjectCache();
     return result;
 }
 
+size_t BoxTypeless::getManyInto(const std::vector<obx_id>& ids, std::vector<uint8_t>& arena,
+                                std::vector<ArenaRange>& outRanges) {
+    outRanges.assign(ids.size(), ArenaRange{0, 0});
+    arena.clear();
+    if (ids.empty()) return 0;
+
+    CursorTx cursor(TxMode::READ, store_, entityTypeId_);
+
+    // First pass: collect data pointers (valid while the TX is active) and compute each object's offset in the arena
+    std::vector<const void*> dataPtrs(ids.size(), nullptr);
+    size_t arenaSize = 0;
+    size_t found = 0;
+    for (size_t index : internal::idOrderAscending(ids)) {
+        const void* data;
+        size_t size;
+        if (!get(cursor, ids[index], &data, &size)) continue;  // leave size zero at outRanges[index] in this case
+        arenaSize = (arenaSize + 7) & ~static_cast<size_t>(7);  // 8-byte alignment for FlatBuffers
+        dataPtrs[index] = data;
+        outRanges[index] = ArenaRange{arenaSize, size};
+        arenaSize += size;
+        found++;
+    }
+
+    // Second pass: copy into the arena, which is allocated just once
+    arena.resize(arenaSize);
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (dataPtrs[i]) memcpy(arena.data() + outRanges[i].offset, dataPtrs[i], outRanges[i].size);
+    }
+    return found;
+}
+
 #endif
 
 /// \brief A Box offers database operations for objects of a specific type.
@@ -2728,25 +4000,22 @@ public:
     using BoxTypeless::get;
 
     /// Read an object from the database, replacing the contents of an existing object variable.
+    /// Uses the object cache if enabled (see enableObjectCache()).
     /// @return true on success, false if the ID was not found, in which case outObject is untouched.
     bool get(obx_id id, EntityT& outObject) {
-        CursorTx ctx(TxMode::READ, store_, EntityBinding::entityId());
-        const void* data;
-        size_t size;
-        if (!get(ctx, id, &data, &size)) return false;
-        EntityBinding::fromFlatBuffer(data, size, outObject);
-        return true;
+        return getCached(id, [&outObject](const void* data, size_t size) {
+            EntityBinding::fromFlatBuffer(data, size, outObject);
+        });
     }
 
 #ifdef __cpp_lib_optional
     /// Read an object from the database.
+    /// Uses the object cache if enabled (see enableObjectCache()).
     /// @return an "optional" wrapper of the object; empty if an object with the given ID doesn't exist.
     std::optional<EntityT> getOptional(obx_id id) {
-        CursorTx ctx(TxMode::READ, store_, EntityBinding::entityId());
-        const void* data;
-        size_t size;
-        if (!BoxTypeless::get(ctx, id, &data, &size)) return std::nullopt;
-        return EntityBinding::fromFlatBuffer(data, size);
+        std::optional<EntityT> result;
+        getCached(id, [&result](const void* data, size_t size) { result = EntityBinding::fromFlatBuffer(data, size); });
+        return result;
     }
 #endif
 
@@ -2784,9 +4053,32 @@ public:
         }
         if (err != OBX_NOT_FOUND) internal::checkErrOrThrow(err);
 
+        if (entityMetrics_) entityMetrics_->addGets(result.size());
         return result;
     }
 
+    /// Walks over all objects of the Box in a single read transaction as zero-copy views, i.e. without reading objects
+    /// and thus without any per-object allocation.
+    /// Unless called inside an outer transaction, a view is only valid until the given visitor returns.
+    /// @param visitor a callable taking a view (see EntityViewType), e.g. const ObjectView<EntityT>&, and returning
+    ///        true to continue visiting or false to stop.
+    /// An exception thrown by the visitor stops visiting and is propagated unchanged (like Query::forEachView()).
+    template <typename Visitor>
+    void forEachView(Visitor visitor) {
+        using ViewT = typename EntityViewType<EntityT>::type;
+
+        CursorTx cursor(TxMode::READ, store_, EntityBinding::entityId());
+        const void* data;
+        size_t size;
+
+        obx_err err = obx_cursor_first(cursor.cPtr(), &data, &size);
+        while (err == OBX_SUCCESS) {
+            if (!visitor(ViewT(data, size))) return;
+            err = obx_cursor_next(cursor.cPtr(), &data, &size);
+        }
+        if (err != OBX_NOT_FOUND) internal::checkErrOrThrow(err);
+    }
+
 #ifndef OBX_DISABLE_FLATBUFFERS
 
     /// Inserts or updates the given object in the database.
@@ -3014,6 +4306,7 @@ private:
         }
         internal::threadLocalFbbDone();  // NOTE might not get called in case of an exception
         cursor.commitAndClose();
+        if (entityMetrics_) entityMetrics_->addPuts(count);
         return count;
     }
 
@@ -3055,13 +4348,17 @@ private:
         const void* data;
         size_t size;
 
-        for (size_t i = 0; i < ids.size(); i++) {
+        // Look up in ascending ID order to traverse the database sequentially; the result still index-matches ids
+        size_t found = 0;
+        for (size_t i : internal::idOrderAscending(ids)) {
             obx_err err = obx_cursor_get(cursor.cPtr(), ids[i], &data, &size);
             if (err == OBX_NOT_FOUND) continue;  // leave empty at result[i] in this case
             internal::checkErrOrThrow(err);
             readFromFb(result[i], data, size);
+            found++;
         }
 
+        if (entityMetrics_) entityMetrics_->addGets(found);
         return result;
     }
 
@@ -3164,6 +4461,160 @@ public:
     bool awaitSubmitted() { return obx_store_await_async_submitted(store_.cPtr()); }
 };
 
+/// \brief Merges synchronous writes from concurrent threads into shared write transactions ("group commit").
+///
+/// Each write transaction is committed (made durable) on its own, and write transactions are serialized.
+/// Thus, with many threads writing small amounts of data, committing dominates.
+/// With GroupCommit, the first caller becomes the "leader" and waits up to maxWait (or until maxOperations are
+/// pending) for other threads to join; then it runs all pending operations in a single write transaction.
+/// Unlike AsyncBox, calls are still synchronous: each call returns once its data is committed or throws its error.
+///
+/// If the shared transaction fails, each of its operations is run again in its own transaction to isolate the error.
+/// Thus, operations must not depend on side effects of a previous (failed) run; e.g. put() only sets the object ID
+/// after the commit succeeded.
+/// Note: operations may run on another thread (the leader's); the calling thread is blocked until it completes.
+/// Calling GroupCommit from within a transaction is not supported (the operation would not be part of it); run()
+/// throws IllegalStateException if the calling thread has an active transaction of the store.
+class GroupCommit {
+    struct Operation {
+        std::function<void()> fn;
+        std::exception_ptr error;
+        bool done = false;
+    };
+
+    Store& store_;
+    const std::chrono::microseconds maxWait_;
+    const size_t maxOperations_;
+
+    std::mutex mutex_;
+    std::condition_variable leaderCondition_;  ///< Leader waits for more operations to join the group
+    std::condition_variable doneCondition_;    ///< Other callers wait for their operation to be done
+    std::vector<Operation*> pending_;
+    bool leaderActive_ = false;
+
+public:
+    /// @param maxWait how long the leader waits for other operations before committing; adds latency to single writes
+    /// @param maxOperations the maximum number of operations per transaction; a full group is committed immediately
+    explicit GroupCommit(Store& store, std::chrono::microseconds maxWait = std::chrono::microseconds(200),
+                         size_t maxOperations = 1000);
+
+    /// Can't be copied or moved: callers may be waiting on it
+    GroupCommit(const GroupCommit&) = delete;
+
+    /// Runs the given function in a write transaction shared with other callers and returns once it is committed.
+    /// The function is typically a single put or remove using a Box; it must not create a transaction on its own.
+    /// @throws the exception thrown by the function or by committing its transaction
+    /// @throws IllegalStateException if called within a transaction of the store on the current thread
+    void run(std::function<void()> fn);
+
+    /// Puts the given object using a shared write transaction and returns once it is committed.
+    /// @return the ID of the object; for an insert, it is also set on the object after the commit succeeded.
+    template <typename EntityT>
+    obx_id put(EntityT& object, OBXPutMode mode = OBXPutMode_PUT) {
+        obx_id id = 0;
+        run([&]() {
+            Box<EntityT> box(store_);
+            id = box.put(const_cast<const EntityT&>(object), mode);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        });
+        EntityT::_OBX_MetaInfo::setObjectId(object, id);
+        return id;
+    }
+
+    /// Removes the object with the given ID using a shared write transaction and returns once it is committed.
+    /// @returns whether the object was removed or not (because it didn't exist)
+    template <typename EntityT>
+    bool remove(obx_id id) {
+        bool removed = false;
+        run([&]() {
+            Box<EntityT> box(store_);
+            removed = box.remove(id);
+        });
+        return removed;
+    }
+
+private:
+    /// Runs the given operations in a single transaction; on failure, runs each in its own transaction.
+    void commit(const std::vector<Operation*>& operations);
+};
+
+#ifdef OBX_CPP_FILE
+GroupCommit::GroupCommit(Store& store, std::chrono::microseconds maxWait, size_t maxOperations)
+    : store_(store), maxWait_(maxWait), maxOperations_(maxOperations) {
+    if (maxOperations == 0) throw IllegalArgumentException("Max operations must be greater than zero");
+}
+
+void GroupCommit::run(std::function<void()> fn) {
+    OBX_VERIFY_STATE(Transaction::threadDepth(store_.cPtr()) == 0);
+    Operation operation;
+    operation.fn = std::move(fn);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    pending_.push_back(&operation);
+    if (pending_.size() >= maxOperations_) leaderCondition_.notify_one();
+
+    while (!operation.done) {
+        if (leaderActive_) {
+            doneCondition_.wait(lock);
+            continue;
+        }
+
+        // Become the leader: give other threads a chance to join, then commit the group (without holding the lock)
+        leaderActive_ = true;
+        struct LeaderReset {  // Also on exceptions (e.g. bad_alloc), as other callers would wait forever otherwise
+            GroupCommit& groupCommit;
+            ~LeaderReset() {  // The lock is held again at this point
+                groupCommit.leaderActive_ = false;
+                groupCommit.doneCondition_.notify_all();  // Also lets a remaining caller become the next leader
+            }
+        } leaderReset{*this};
+
+        leaderCondition_.wait_for(lock, maxWait_, [this]() { return pending_.size() >= maxOperations_; });
+        size_t count = std::min(pending_.size(), maxOperations_);
+        std::vector<Operation*> group;
+        try {
+            group.assign(pending_.begin(), pending_.begin() + count);
+        } catch (...) {
+            pending_.erase(std::find(pending_.begin(), pending_.end(), &operation));  // Still pending: not in a group
+            throw;
+        }
+        pending_.erase(pending_.begin(), pending_.begin() + count);
+        lock.unlock();
+
+        commit(group);  // Does not throw: errors are kept per operation
+
+        lock.lock();
+        for (Operation* op : group) op->done = true;
+    }
+    lock.unlock();
+
+    if (operation.error) std::rethrow_exception(operation.error);
+}
+
+void GroupCommit::commit(const std::vector<Operation*>& operations) {
+    try {
+        Transaction tx = store_.txWrite();
+        for (Operation* op : operations) op->fn();
+        tx.success();
+        return;
+    } catch (...) {
+        if (operations.size() == 1) {
+            operations[0]->error = std::current_exception();
+            return;
+        }
+    }
+
+    for (Operation* op : operations) {
+        try {
+            Transaction tx = store_.txWrite();
+            op->fn();
+            tx.success();
+        } catch (...) {
+            op->error = std::current_exception();
+        }
+    }
+}
+#endif  // OBX_CPP_FILE
+
 using AsyncStatusCallback = std::function<void(obx_err err)>;
 
 /// @brief Removal of expired objects; see OBXPropertyFlags_EXPIRATION_TIME.
@@ -3209,71 +4660,2123 @@ void ExpiredObjects::removeAsync(Store& store, obx_schema_id typeId, AsyncStatus
 
 #endif  // OBX_CPP_FILE
 
-/// @brief Structural/behavioral options for a tree passed during tree creation.
-class TreeOptions {
-    friend class Tree;
+/// Receives the bytes of a backup stream, e.g. to write them to a file, compress them or send them over the network.
+using BackupSink = std::function<void(const void* data, size_t size)>;
 
-    OBX_tree_options* cOptions_;
-    char pathDelimiter_ = '/';
+/// Provides the bytes of a backup stream: reads up to size bytes into buffer and returns the number of bytes read;
+/// returns 0 at the end of the stream.
+using BackupSource = std::function<size_t(void* buffer, size_t size)>;
 
-public:
-    TreeOptions() : cOptions_(obx_tree_options()) {
-        internal::checkPtrOrThrow(cOptions_, "Could not create tree options");
-    }
+/// \brief The state of the data at the time of a backup (a hash per object) to create incremental backups from.
+///
+/// Created by IncrementalBackup::backUp(); save it (e.g. next to the backup) to use it as the base of the next
+/// incremental backup. Memory usage is 32 bytes per object.
+class BackupManifest {
+    friend class IncrementalBackup;
+
+    struct ObjectHash {
+        obx_id id;
+        uint64_t size;     ///< Size of the object's bytes
+        uint64_t hash[2];  ///< 128-bit hash of the object's bytes
+    };
 
-    /// Move constructor "stealing" the C resource from the source
-    TreeOptions(TreeOptions&& source) noexcept : cOptions_(source.cOptions_) { source.cOptions_ = nullptr; }
+    struct TypeHashes {
+        obx_schema_id typeId;
+        std::vector<ObjectHash> objects;  ///< Ordered by ID
+    };
 
-    ~TreeOptions() { obx_tree_options_free(cOptions_); }
+    uint64_t backupId_ = 0;
+    std::vector<TypeHashes> types_;
 
-    /// Can't be copied, single owner of C resources is required (to avoid double-free during destruction)
-    TreeOptions(const TreeOptions&) = delete;
+public:
+    /// The ID of the backup this manifest was created with; 0 for an empty manifest.
+    uint64_t backupId() const { return backupId_; }
 
-    /// Adjusts the path delimiter character, which is by default "/".
-    TreeOptions& pathDelimiter(char delimiter) {
-        obx_err err = obx_tree_opt_path_delimiter(cOptions_, delimiter);
-        internal::checkErrOrThrow(err);
-        pathDelimiter_ = delimiter;
-        return *this;
-    }
+    /// Writes this manifest to the given sink; see load().
+    void save(const BackupSink& sink) const;
 
-    /// Sets the given OBXTreeOptionFlags. Combine multiple flags using bitwise OR.
-    TreeOptions& flags(uint32_t flags) {
-        obx_err err = obx_tree_opt_flags(cOptions_, flags);
-        internal::checkErrOrThrow(err);
-        return *this;
-    }
+    /// Reads a manifest previously written by save().
+    /// @throws DbException if the data is not a valid manifest
+    static BackupManifest load(const BackupSource& source);
+
+private:
+    const TypeHashes* find(obx_schema_id typeId) const;
 };
 
-/// Regular results in the sense of "not throwing an exception" for put operations via TreeCursor.
-enum class TreePutResult {
-    Undefined,     ///< Not an actual result, will never be returned from a synchronous put operation;
-                   ///< when used in AsyncTreePutResult, however, this indicates an exceptional result.
-    Success,       ///< OK
-    PathNotFound,  ///< Given path did not exist (no meta leaf object given to create it)
-    DidNotPut      ///< According to the given put mode, no put was performed, e.g. "insert but already existed"
+/// \brief Creates full and incremental (delta) backups of objects as a stream, e.g. to compress and ship them.
+///
+/// A full backup contains all objects of the given entity types; an incremental backup contains only the objects that
+/// were added or changed, and the IDs of removed objects, since the backup of a given BackupManifest.
+/// Changes are detected by comparing the size and a hash of each object, so creating a backup still reads all objects
+/// (in a single read transaction, i.e. a consistent snapshot), but only changes are written, which is much less I/O
+/// for large stores. To restore, apply the full backup and then its chain of incremental backups in order using
+/// restore().
+///
+/// The hash is MurmurHash3 (x64, 128 bits). A changed object is only missed if its size is unchanged and its hash
+/// collides with the previous one; for regular data, the chance is about 2^-128 per changed object. MurmurHash3 is not
+/// a cryptographic hash though: objects crafted to collide deliberately would go unnoticed. If that is a concern,
+/// create full backups (which contain all objects) instead.
+///
+/// Restoring keeps the object IDs. To keep IDs assigned later by the store from colliding with restored objects, the
+/// ID sequence of each type is advanced beyond the restored IDs by reserving IDs (see obx_cursor_id_for_put()); thus,
+/// restoring into a fresh store takes time proportional to the highest ID. To bound this, a restored ID more than
+/// 1,000,000 above the ID sequence fails the restore (DbException). Types with self-assignable IDs (see
+/// OBXPropertyFlags_ID_SELF_ASSIGNABLE) accept IDs above their sequence as is, which is left to the application.
+///
+/// Unlike Store::backUpToFile(), this works on objects, not on database pages, and is thus independent of the DB
+/// file layout. Standalone relations (see obx_cursor_rel_put()) are not included.
+/// The stream format uses the native byte order; restore on a platform with the same byte order.
+class IncrementalBackup {
+    Store& store_;
+    std::vector<obx_schema_id> typeIds_;
+
+public:
+    /// @param typeIds the entity types to include in backups
+    IncrementalBackup(Store& store, std::vector<obx_schema_id> typeIds);
+
+    /// Writes a backup to the given sink: a full backup if base is nullptr, otherwise the changes since base.
+    /// @returns the manifest of this backup, i.e. the base for the next incremental backup
+    BackupManifest backUp(const BackupSink& sink, const BackupManifest* base = nullptr);
+
+    /// Applies a backup stream (full or incremental) in a single write transaction.
+    /// A full backup replaces all objects of its entity types.
+    /// @param previousBackupId for an incremental backup, the ID of the backup applied before (the backup's base);
+    ///        ensures that a chain of backups is applied completely and in order. Ignored for full backups.
+    /// @returns the ID of the applied backup, i.e. the previousBackupId for the next backup in the chain
+    /// @throws DbException if the stream is invalid or does not continue the chain
+    static uint64_t restore(Store& store, const BackupSource& source, uint64_t previousBackupId = 0);
 };
 
-namespace internal {
-TreePutResult mapErrorToTreePutResult(obx_err err);
-}  // namespace internal
+#ifdef OBX_CPP_FILE
+namespace {
+const char backupStreamMagic[8] = {'O', 'B', 'X', 'D', 'E', 'L', 'T', 'A'};
+const char backupManifestMagic[8] = {'O', 'B', 'X', 'M', 'A', 'N', 'I', 'F'};
+const uint32_t backupStreamVersion = 1;
+const uint32_t backupManifestVersion = 2;  // 1 had 64-bit hashes without the size
 
-/// Parameter to AsyncTreePutCallback, which is passed to Tree::putAsync().
-struct AsyncTreePutResult {
-    TreePutResult result;      ///< Non-exceptional results or "Undefined"; in the latter case obx_err has more details
-    obx_err status;            ///< More detailed error code if operation did not succeed
-    obx_id id;                 ///< ID of the leaf that was put if operation succeeded
-    std::string errorMessage;  ///< Non-empty if an error occurred (result is "Undefined")
+/// ExplicitIdPreparer reserves at most this many IDs to advance an ID sequence beyond a single given ID.
+const obx_id maxReservedIdGap = 1000000;
 
-    ///@returns true if the operation was successful.
-    inline bool isSuccess() { return status == OBX_SUCCESS; }
+enum class BackupRecord : uint8_t { End = 0, RemoveAll = 1, Put = 2, Remove = 3 };
 
-    /// Alternative to checking error codes: throw an exception instead.
-    /// Note that this will always throw, so you should at least check for a successful outcome, e.g. via isSuccess().
-    [[noreturn]] void throwException() { internal::throwError(status, "Async tree put failed: " + errorMessage); }
-};
+/// Buffers small writes to pass larger chunks to the sink.
+class BackupWriter {
+    const BackupSink& sink_;
+    std::vector<uint8_t> buffer_;
 
-struct AsyncTreeGetResult {
+public:
+    explicit BackupWriter(const BackupSink& sink) : sink_(sink) { buffer_.reserve(1024 * 1024); }
+
+    void write(const void* data, size_t size) {
+        if (buffer_.size() + size > buffer_.capacity()) flush();
+        if (size >= buffer_.capacity()) {
+            sink_(data, size);
+        } else {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            buffer_.insert(buffer_.end(), bytes, bytes + size);
+        }
+    }
+
+    template <typename T>
+    void write(T value) {
+        write(&value, sizeof(T));
+    }
+
+    void flush() {
+        if (!buffer_.empty()) sink_(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+};
+
+class BackupReader {
+    const BackupSource& source_;
+
+public:
+    explicit BackupReader(const BackupSource& source) : source_(source) {}
+
+    void read(void* buffer, size_t size) {
+        uint8_t* bytes = static_cast<uint8_t*>(buffer);
+        while (size > 0) {
+            size_t count = source_(bytes, size);
+            if (count == 0) throw DbException("Backup stream ended unexpectedly", OBX_ERROR_BACKUP_FILE_INVALID);
+            bytes += count;
+            size -= count;
+        }
+    }
+
+    template <typename T>
+    T read() {
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+
+    /// Reads count elements into out (replacing its content). As count comes from the stream, out grows in bounded
+    /// steps while the data is actually read: a corrupt count ends the stream (DbException) instead of allocating.
+    template <typename T>
+    void read(std::vector<T>& out, uint64_t count) {
+        const size_t chunkSize = std::max(size_t(1), (1024 * 1024) / sizeof(T));
+        out.clear();
+        while (out.size() < count) {
+            size_t offset = out.size();
+            size_t chunk = static_cast<size_t>(std::min<uint64_t>(count - offset, chunkSize));
+            out.resize(offset + chunk);
+            read(out.data() + offset, chunk * sizeof(T));
+        }
+    }
+
+    void expectHeader(const char (&magic)[8], uint32_t version) {
+        char actual[8];
+        read(actual, sizeof(actual));
+        if (memcmp(actual, magic, sizeof(actual)) != 0 || read<uint32_t>() != version) {
+            throw DbException("Unsupported or invalid backup data", OBX_ERROR_BACKUP_FILE_INVALID);
+        }
+    }
+};
+
+/// Prepares putting objects with given IDs via obx_cursor_put() (e.g. restored or copied objects), so that IDs assigned
+/// later by the store do not collide with them: for each type, the ID sequence is advanced beyond the given IDs by
+/// reserving IDs (obx_cursor_id_for_put() with zero). If the store accepts an ID above the sequence as is (the type's
+/// IDs are self-assignable), no IDs are reserved for that type. Passing IDs in ascending order (per type) is fastest.
+/// As each reserved ID is a call into the store, an ID more than maxReservedIdGap above the sequence throws instead.
+class ExplicitIdPreparer {
+    struct TypeState {
+        obx_schema_id typeId;
+        obx_id reservedUpTo;  ///< IDs up to this one are below the sequence
+        bool selfAssignable;
+    };
+    std::vector<TypeState> types_;
+
+public:
+    /// @param cursor a cursor of the given type in the write transaction used to put the object
+    void prepare(OBX_cursor* cursor, obx_schema_id typeId, obx_id id) {
+        TypeState& type = state(typeId);
+        if (id <= type.reservedUpTo || type.selfAssignable) return;
+        obx_id reserved = reserve(cursor);
+        if (reserved < id && obx_cursor_id_for_put(cursor, id) == id) {  // Above the sequence: self-assignable IDs
+            type.selfAssignable = true;
+            return;
+        }
+        if (reserved < id && id - reserved > maxReservedIdGap) {
+            throw DbException("Can not put object ID " + std::to_string(id) + " of entity type " +
+                                  std::to_string(typeId) + ": it is " + std::to_string(id - reserved) +
+                                  " IDs above the ID sequence, but at most " + std::to_string(maxReservedIdGap) +
+                                  " are reserved; use self-assignable IDs (OBXPropertyFlags_ID_SELF_ASSIGNABLE)",
+                              OBX_ERROR_ILLEGAL_STATE);
+        }
+        while (reserved < id) reserved = reserve(cursor);
+        type.reservedUpTo = reserved;
+    }
+
+private:
+    TypeState& state(obx_schema_id typeId) {
+        for (TypeState& type : types_) {
+            if (type.typeId == typeId) return type;
+        }
+        types_.push_back({typeId, 0, false});
+        return types_.back();
+    }
+
+    static obx_id reserve(OBX_cursor* cursor) {
+        obx_id id = obx_cursor_id_for_put(cursor, 0);
+        internal::checkIdOrThrow(id, "Could not reserve an ID");
+        return id;
+    }
+};
+
+inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t fmix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+/// MurmurHash3 x64 128-bit (seed 0) of the given bytes to detect changed objects; words are read in native byte order.
+void backupHash(const void* data, size_t size, uint64_t (&out)[2]) {
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t h1 = 0;
+    uint64_t h2 = 0;
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint64_t k1;
+        uint64_t k2;
+        memcpy(&k1, bytes + i, sizeof(k1));
+        memcpy(&k2, bytes + i + 8, sizeof(k2));
+        h1 ^= rotl64(k1 * c1, 31) * c2;
+        h1 = (rotl64(h1, 27) + h2) * 5 + 0x52dce729;
+        h2 ^= rotl64(k2 * c2, 33) * c1;
+        h2 = (rotl64(h2, 31) + h1) * 5 + 0x38495ab5;
+    }
+
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    for (size_t tail = 0; i + tail < size; tail++) {
+        uint64_t byte = bytes[i + tail];
+        if (tail < 8) {
+            k1 ^= byte << (tail * 8);
+        } else {
+            k2 ^= byte << ((tail - 8) * 8);
+        }
+    }
+    if (size - i > 8) h2 ^= rotl64(k2 * c2, 33) * c1;
+    if (size - i > 0) h1 ^= rotl64(k1 * c1, 31) * c2;
+
+    h1 ^= size;
+    h2 ^= size;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+    out[0] = h1;
+    out[1] = h2;
+}
+}  // namespace
+
+const BackupManifest::TypeHashes* BackupManifest::find(obx_schema_id typeId) const {
+    for (const TypeHashes& type : types_) {
+        if (type.typeId == typeId) return &type;
+    }
+    return nullptr;
+}
+
+void BackupManifest::save(const BackupSink& sink) const {
+    BackupWriter writer(sink);
+    writer.write(backupManifestMagic, sizeof(backupManifestMagic));
+    writer.write(backupManifestVersion);
+    writer.write(backupId_);
+    writer.write(static_cast<uint64_t>(types_.size()));
+    for (const TypeHashes& type : types_) {
+        writer.write(type.typeId);
+        writer.write(static_cast<uint64_t>(type.objects.size()));
+        if (!type.objects.empty()) writer.write(type.objects.data(), type.objects.size() * sizeof(ObjectHash));
+    }
+    writer.flush();
+}
+
+BackupManifest BackupManifest::load(const BackupSource& source) {
+    BackupReader reader(source);
+    reader.expectHeader(backupManifestMagic, backupManifestVersion);
+    BackupManifest manifest;
+    manifest.backupId_ = reader.read<uint64_t>();
+    uint64_t typeCount = reader.read<uint64_t>();
+    for (uint64_t i = 0; i < typeCount; i++) {  // No reserve(): the count is not trusted (see BackupReader)
+        manifest.types_.push_back({reader.read<obx_schema_id>(), {}});
+        TypeHashes& type = manifest.types_.back();
+        reader.read(type.objects, reader.read<uint64_t>());
+    }
+    return manifest;
+}
+
+IncrementalBackup::IncrementalBackup(Store& store, std::vector<obx_schema_id> typeIds)
+    : store_(store), typeIds_(std::move(typeIds)) {
+    if (typeIds_.empty()) throw IllegalArgumentException("At least one entity type is required");
+}
+
+BackupManifest IncrementalBackup::backUp(const BackupSink& sink, const BackupManifest* base) {
+    BackupManifest manifest;
+    manifest.backupId_ = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    if (base && manifest.backupId_ <= base->backupId_) manifest.backupId_ = base->backupId_ + 1;
+
+    BackupWriter writer(sink);
+    writer.write(backupStreamMagic, sizeof(backupStreamMagic));
+    writer.write(backupStreamVersion);
+    writer.write(manifest.backupId_);
+    writer.write(base ? base->backupId_ : uint64_t(0));
+
+    auto writeRecord = [&writer](BackupRecord record, obx_schema_id typeId, obx_id id) {
+        writer.write(record);
+        writer.write(typeId);
+        writer.write(id);
+    };
+
+    Transaction tx = store_.txRead();
+    for (obx_schema_id typeId : typeIds_) {
+        const BackupManifest::TypeHashes* baseType = base ? base->find(typeId) : nullptr;
+        if (!base) writeRecord(BackupRecord::RemoveAll, typeId, 0);
+        size_t baseIndex = 0;
+
+        manifest.types_.push_back({typeId, {}});
+        std::vector<BackupManifest::ObjectHash>& hashes = manifest.types_.back().objects;
+
+        OBX_cursor* cursor = internal::checkedPtrOrThrow(obx_cursor(tx.cPtr(), typeId), "Can not open cursor");
+        try {
+            const void* data;
+            size_t size;
+            obx_err err = obx_cursor_first(cursor, &data, &size);
+            while (err == OBX_SUCCESS) {
+                obx_id id = 0;
+                internal::checkErrOrThrow(obx_cursor_current_id(cursor, &id));
+                BackupManifest::ObjectHash hash = {id, size, {0, 0}};
+                backupHash(data, size, hash.hash);
+                hashes.push_back(hash);
+
+                // Both, the cursor and the base, are ordered by ID: base objects before this ID were removed
+                bool unchanged = false;
+                if (baseType) {
+                    const std::vector<BackupManifest::ObjectHash>& baseObjects = baseType->objects;
+                    while (baseIndex < baseObjects.size() && baseObjects[baseIndex].id < id) {
+                        writeRecord(BackupRecord::Remove, typeId, baseObjects[baseIndex++].id);
+                    }
+                    if (baseIndex < baseObjects.size() && baseObjects[baseIndex].id == id) {
+                        const BackupManifest::ObjectHash& baseHash = baseObjects[baseIndex++];
+                        unchanged = baseHash.size == hash.size && baseHash.hash[0] == hash.hash[0] &&
+                                    baseHash.hash[1] == hash.hash[1];
+                    }
+                }
+                if (!unchanged) {
+                    writeRecord(BackupRecord::Put, typeId, id);
+                    writer.write(static_cast<uint64_t>(size));
+                    writer.write(data, size);
+                }
+                err = obx_cursor_next(cursor, &data, &size);
+            }
+            if (err != OBX_NOT_FOUND) internal::checkErrOrThrow(err);
+        } catch (...) {
+            obx_cursor_close(cursor);
+            throw;
+        }
+        obx_cursor_close(cursor);
+
+        if (baseType) {
+            for (; baseIndex < baseType->objects.size(); baseIndex++) {
+                writeRecord(BackupRecord::Remove, typeId, baseType->objects[baseIndex].id);
+            }
+        }
+    }
+    writer.write(BackupRecord::End);
+    writer.flush();
+    return manifest;
+}
+
+uint64_t IncrementalBackup::restore(Store& store, const BackupSource& source, uint64_t previousBackupId) {
+    BackupReader reader(source);
+    reader.expectHeader(backupStreamMagic, backupStreamVersion);
+    uint64_t backupId = reader.read<uint64_t>();
+    uint64_t baseBackupId = reader.read<uint64_t>();
+    if (baseBackupId != 0 && baseBackupId != previousBackupId) {
+        throw DbException("Incremental backup " + std::to_string(backupId) + " requires backup " +
+                              std::to_string(baseBackupId) + " to be restored before",
+                          OBX_ERROR_BACKUP_FILE_INVALID);
+    }
+
+    Transaction tx = store.txWrite();
+    obx_schema_id cursorTypeId = 0;
+    OBX_cursor* cursor = nullptr;
+    ExplicitIdPreparer idPreparer;
+    std::vector<uint8_t> data;
+    try {
+        BackupRecord record;
+        while ((record = reader.read<BackupRecord>()) != BackupRecord::End) {
+            obx_schema_id typeId = reader.read<obx_schema_id>();
+            obx_id id = reader.read<obx_id>();
+            if (cursor == nullptr || typeId != cursorTypeId) {
+                obx_cursor_close(cursor);
+                cursor = nullptr;
+                cursor = internal::checkedPtrOrThrow(obx_cursor(tx.cPtr(), typeId), "Can not open cursor");
+                cursorTypeId = typeId;
+            }
+            if (record == BackupRecord::RemoveAll) {
+                internal::checkErrOrThrow(obx_cursor_remove_all(cursor));
+            } else if (record == BackupRecord::Put) {
+                reader.read(data, reader.read<uint64_t>());
+                idPreparer.prepare(cursor, typeId, id);
+                internal::checkErrOrThrow(obx_cursor_put(cursor, id, data.data(), data.size()));
+            } else if (record == BackupRecord::Remove) {
+                obx_err err = obx_cursor_remove(cursor, id);
+                if (err != OBX_NOT_FOUND) internal::checkErrOrThrow(err);
+            } else {
+                throw DbException("Invalid backup record", OBX_ERROR_BACKUP_FILE_INVALID);
+            }
+        }
+    } catch (...) {
+        obx_cursor_close(cursor);
+        throw;
+    }
+    obx_cursor_close(cursor);
+    tx.success();
+    return backupId;
+}
+#endif  // OBX_CPP_FILE
+
+/// Progress of a StoreCompaction, reported after each committed batch.
+struct CompactionProgress {
+    obx_schema_id typeId;  ///< The entity type currently copied
+    uint64_t objects;      ///< Objects copied so far (all types)
+    uint64_t bytes;        ///< Object bytes copied so far (all types)
+};
+
+/// Result of StoreCompaction::run().
+struct CompactionResult {
+    uint64_t objects;           ///< Objects copied
+    uint64_t bytes;             ///< Object bytes copied
+    uint64_t sizeOnDiskBefore;  ///< Size of the source store on disk when the compaction started
+    uint64_t sizeOnDiskAfter;   ///< Size of the target (compacted) store on disk after copying
+};
+
+/// \brief Copies all objects of a store into a new store, which is compact: e.g. to reclaim disk space after bulk
+/// removals (the DB file of a store does not shrink) and to get a contiguous data layout.
+///
+/// Objects are read from a single read transaction of the source store, so readers and writers of the source store
+/// continue to work meanwhile. Changes made after the compaction started are not part of the target store, thus stop
+/// writing to the source before switching to the target (e.g. by closing both and swapping their directories).
+/// Object IDs are preserved; the target store must use the same data model and should be empty. The target's ID
+/// sequences are advanced beyond the copied IDs (like IncrementalBackup::restore()), so new objects get new IDs.
+/// This reserves IDs one by one; thus, a gap of more than 1,000,000 IDs between copied objects (e.g. after removing
+/// most objects) fails the compaction, unless the type's IDs are self-assignable (OBXPropertyFlags_ID_SELF_ASSIGNABLE).
+/// Writes to the target are split into transactions of bounded size and can be rate-limited to bound the I/O impact.
+/// Standalone relations (see obx_cursor_rel_put()) are not copied.
+class StoreCompaction {
+    Store& source_;
+    Store& target_;
+    std::vector<obx_schema_id> typeIds_;
+    uint64_t maxBytesPerSecond_ = 0;
+    size_t maxBytesPerTx_ = 64 * 1024 * 1024;
+    std::function<void(const CompactionProgress&)> progressListener_;
+
+public:
+    /// @param typeIds the entity types to copy
+    StoreCompaction(Store& source, Store& target, std::vector<obx_schema_id> typeIds);
+
+    /// Limits the copy rate to the given number of object bytes per second; 0 (default) means no limit.
+    StoreCompaction& maxBytesPerSecond(uint64_t bytesPerSecond) {
+        maxBytesPerSecond_ = bytesPerSecond;
+        return *this;
+    }
+
+    /// Commits the target store's write transaction once it reaches this number of object bytes (default 64 MB).
+    StoreCompaction& maxBytesPerTransaction(size_t bytes) {
+        maxBytesPerTx_ = std::max(bytes, size_t(1));
+        return *this;
+    }
+
+    /// Called after each committed transaction on the calling thread.
+    StoreCompaction& onProgress(std::function<void(const CompactionProgress&)> listener) {
+        progressListener_ = std::move(listener);
+        return *this;
+    }
+
+    /// Copies the objects; blocks until done.
+    /// @throws DbException if an object ID is too far above the target's ID sequence (see the class docs); batches
+    ///         committed before remain in the target store.
+    CompactionResult run();
+};
+
+#ifdef OBX_CPP_FILE
+StoreCompaction::StoreCompaction(Store& source, Store& target, std::vector<obx_schema_id> typeIds)
+    : source_(source), target_(target), typeIds_(std::move(typeIds)) {
+    if (&source == &target) throw IllegalArgumentException("Source and target stores must be different");
+    if (typeIds_.empty()) throw IllegalArgumentException("At least one entity type is required");
+}
+
+CompactionResult StoreCompaction::run() {
+    CompactionResult result{0, 0, source_.getDbSizeOnDisk(), 0};
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    Transaction readTx = source_.txRead();  // Outer transaction: all types are read from the same snapshot
+    ExplicitIdPreparer idPreparer;           // Advances the target's ID sequences beyond the copied IDs
+    for (obx_schema_id typeId : typeIds_) {
+        CursorTx sourceCursor(TxMode::READ, source_, typeId);
+        const void* data;
+        size_t size;
+        obx_err err = obx_cursor_first(sourceCursor.cPtr(), &data, &size);
+        while (err == OBX_SUCCESS) {
+            size_t txBytes = 0;
+            {
+                CursorTx targetCursor(TxMode::WRITE, target_, typeId);
+                while (err == OBX_SUCCESS && txBytes < maxBytesPerTx_) {
+                    obx_id id = 0;
+                    internal::checkErrOrThrow(obx_cursor_current_id(sourceCursor.cPtr(), &id));
+                    idPreparer.prepare(targetCursor.cPtr(), typeId, id);
+                    internal::checkErrOrThrow(obx_cursor_put(targetCursor.cPtr(), id, data, size));
+                    txBytes += size;
+                    result.objects++;
+                    err = obx_cursor_next(sourceCursor.cPtr(), &data, &size);
+                }
+                if (err != OBX_SUCCESS && err != OBX_NOT_FOUND) internal::checkErrOrThrow(err);
+                targetCursor.commitAndClose();
+            }
+            result.bytes += txBytes;
+            if (progressListener_) progressListener_({typeId, result.objects, result.bytes});
+
+            if (maxBytesPerSecond_ > 0) {  // Sleep until the average rate is within the limit
+                std::chrono::duration<double> minDuration(static_cast<double>(result.bytes) / maxBytesPerSecond_);
+                std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+                if (elapsed < minDuration) {
+                    std::this_thread::sleep_for(
+                        std::chrono::duration_cast<std::chrono::steady_clock::duration>(minDuration - elapsed));
+                }
+            }
+        }
+        if (err != OBX_NOT_FOUND) internal::checkErrOrThrow(err);
+    }
+    readTx.close();
+
+    result.sizeOnDiskAfter = target_.getDbSizeOnDisk();
+    return result;
+}
+#endif  // OBX_CPP_FILE
+
+/// Position of a BackgroundValidation within an ID range of an entity type; see BackgroundValidation::positions().
+struct ValidationPosition {
+    obx_schema_id typeId;
+    obx_id lastId;  ///< The last object ID that was visited (or the exclusive start of the range); 0 if not started
+    bool done;      ///< True if all objects of this range were visited
+    obx_id endId;   ///< The last object ID of this range (inclusive); 0 if the range is not bounded
+};
+
+/// An issue found by BackgroundValidation.
+struct ValidationIssue {
+    obx_schema_id typeId;
+    obx_id id;            ///< The affected object or 0 if the issue is not related to a single object
+    int error;            ///< An OBX_ERROR_* code if reading failed; OBX_SUCCESS if the structure check failed
+    std::string message;  ///< Describes the issue
+};
+
+/// \brief Validates the objects of a store in the background while the store is in use, e.g. right after opening.
+///
+/// Options::validateOnOpenPages() validates pages before the store is available; for large databases, this may
+/// delay opening a store considerably. As an alternative (or in addition to a limited number of pages at open time),
+/// this reads all objects (optionally a sample) in the background and reports objects that could not be read.
+/// Further, each object gets an "object structure check" (unless OBX_DISABLE_FLATBUFFERS): its FlatBuffers root
+/// offset and the start of its root table including the vtable must be within the object's bytes. This does not
+/// verify fields (e.g. strings or vectors), which would require the entity's schema.
+/// With multiple threads, entity types are split into ID ranges (see objectsPerRange()), which are validated in
+/// parallel; splitting only iterates over IDs and publishes ranges while it goes, so threads start right away.
+/// Objects are read in short read transactions of bounded size, so the validation does not hold on to old data
+/// (which would prevent reusing free pages).
+/// A validation can be stopped at any time and resumed later (e.g. after the next open) from its positions().
+/// Objects put after the validation passed their ID are not visited; within a range, objects are visited in
+/// ascending ID order.
+class BackgroundValidation {
+    enum class RangeState { Pending, Unsplit, Splitting, Active };
+
+    Store& store_;
+    std::vector<ValidationPosition> positions_;  ///< Guarded by mutex_
+    std::vector<RangeState> states_;             ///< One per position; guarded by mutex_
+    size_t activeSplits_ = 0;                    ///< Guarded by mutex_
+    size_t threadCount_ = 1;
+    double sampleRate_ = 1.0;
+    size_t maxObjectsPerTx_ = 10000;
+    size_t objectsPerRange_ = 100000;
+    std::function<void(const ValidationIssue&)> issueListener_;
+    std::mutex mutex_;
+    std::condition_variable workAvailable_;
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<uint64_t> checkedCount_{0};
+    std::atomic<uint64_t> issueCount_{0};
+    std::vector<std::thread> threads_;
+
+public:
+    /// @param typeIds the entity types to validate
+    BackgroundValidation(Store& store, const std::vector<obx_schema_id>& typeIds);
+
+    /// Stops the validation (see stop()).
+    virtual ~BackgroundValidation();
+
+    /// Can't be copied or moved: the background threads refer to it
+    BackgroundValidation(const BackgroundValidation&) = delete;
+
+    /// Continues at the given positions, e.g. as returned by positions() of a previously stopped validation.
+    /// Positions of types not given to the constructor are ignored. Must be called before start().
+    BackgroundValidation& resumeFrom(const std::vector<ValidationPosition>& positions);
+
+    /// The number of threads validating ID ranges in parallel (default 1).
+    BackgroundValidation& threads(size_t threadCount) {
+        threadCount_ = std::max(threadCount, size_t(1));
+        return *this;
+    }
+
+    /// Only validates the given fraction of objects, e.g. 0.1 for about 10%; default 1.0 (all objects).
+    /// The sample is deterministic (based on object IDs), thus a resumed validation continues with the same sample.
+    /// Object data of the remaining objects is not read.
+    BackgroundValidation& sampleRate(double rate) {
+        if (!(rate > 0.0 && rate <= 1.0)) throw IllegalArgumentException("Sample rate must be in (0, 1]");
+        sampleRate_ = rate;
+        return *this;
+    }
+
+    /// Visits at most this number of objects in a single read transaction (default 10000).
+    BackgroundValidation& maxObjectsPerTransaction(size_t count) {
+        maxObjectsPerTx_ = std::max(count, size_t(1));
+        return *this;
+    }
+
+    /// With more than one thread, splits entity types into ID ranges of this number of objects (default 100000).
+    BackgroundValidation& objectsPerRange(size_t count) {
+        objectsPerRange_ = std::max(count, size_t(1));
+        return *this;
+    }
+
+    /// Called for each issue found; called from a background thread, so it must be thread-safe.
+    BackgroundValidation& onIssue(std::function<void(const ValidationIssue&)> listener) {
+        issueListener_ = std::move(listener);
+        return *this;
+    }
+
+    /// Starts the background threads; returns immediately.
+    /// A stopped validation may be started again; it continues at its current positions().
+    void start();
+
+    /// Requests the threads to stop after their current transaction and waits for them (resumable via positions()).
+    void stop();
+
+    /// Waits until all types were validated (or the validation was stopped).
+    void awaitFinished();
+
+    /// @returns true if all objects of all types were visited
+    bool isFinished();
+
+    /// The current positions of all ID ranges; pass them to resumeFrom() to continue a stopped validation later.
+    std::vector<ValidationPosition> positions();
+
+    /// The number of objects validated so far (objects not part of the sample are not counted).
+    uint64_t checkedCount() const { return checkedCount_.load(std::memory_order_relaxed); }
+
+    /// The number of issues found so far.
+    uint64_t issueCount() const { return issueCount_.load(std::memory_order_relaxed); }
+
+private:
+    void runWorker();
+
+    /// Publishes the ranges of an unbounded position, i.e. splits it into ranges of objectsPerRange_ objects.
+    void splitRange(size_t index);
+
+    /// Reads a single transaction's worth of objects and runs the object structure check (see class docs) on each.
+    /// @returns true if the range is done
+    bool validateBatch(ValidationPosition& position);
+
+    /// @returns the first ID after the given one (which may have been removed meanwhile) or 0 if there is none
+    static obx_id seekToIdAfter(CursorTx& cursor, obx_id lastId);
+
+    bool isSampled(obx_id id) const;
+
+    /// The object structure check: verifies the FlatBuffers root offset and the root table start (incl. its vtable).
+    static bool passesStructureCheck(const void* data, size_t size);
+
+    void reportIssue(ValidationIssue issue);
+};
+
+#ifdef OBX_CPP_FILE
+BackgroundValidation::BackgroundValidation(Store& store, const std::vector<obx_schema_id>& typeIds) : store_(store) {
+    if (typeIds.empty()) throw IllegalArgumentException("At least one entity type is required");
+    for (obx_schema_id typeId : typeIds) positions_.push_back({typeId, 0, false, 0});
+}
+
+BackgroundValidation::~BackgroundValidation() { stop(); }
+
+BackgroundValidation& BackgroundValidation::resumeFrom(const std::vector<ValidationPosition>& positions) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!threads_.empty()) throw IllegalStateException("Validation was already started");
+    auto containsType = [](const std::vector<ValidationPosition>& vec, obx_schema_id typeId) {
+        for (const ValidationPosition& position : vec) {
+            if (position.typeId == typeId) return true;
+        }
+        return false;
+    };
+    std::vector<ValidationPosition> merged;  // The resumed ranges replace all ranges of their type
+    for (const ValidationPosition& position : positions_) {
+        if (!containsType(positions, position.typeId)) merged.push_back(position);
+    }
+    for (const ValidationPosition& resumed : positions) {
+        if (containsType(positions_, resumed.typeId)) merged.push_back(resumed);
+    }
+    positions_ = std::move(merged);
+    return *this;
+}
+
+void BackgroundValidation::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!threads_.empty()) throw IllegalStateException("Validation was already started");
+    stopRequested_ = false;
+    activeSplits_ = 0;
+    states_.clear();
+    for (const ValidationPosition& position : positions_) {
+        bool split = threadCount_ > 1 && !position.done && position.endId == 0;
+        states_.push_back(split ? RangeState::Unsplit : RangeState::Pending);
+    }
+    for (size_t i = 0; i < threadCount_; i++) {
+        threads_.emplace_back(&BackgroundValidation::runWorker, this);
+    }
+}
+
+void BackgroundValidation::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_ = true;
+    }
+    workAvailable_.notify_all();
+    awaitFinished();
+}
+
+void BackgroundValidation::awaitFinished() {
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads.swap(threads_);
+    }
+    for (std::thread& thread : threads) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+bool BackgroundValidation::isFinished() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const ValidationPosition& position : positions_) {
+        if (!position.done) return false;
+    }
+    return true;
+}
+
+std::vector<ValidationPosition> BackgroundValidation::positions() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return positions_;
+}
+
+void BackgroundValidation::runWorker() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopRequested_) {
+        // Prefer splitting, so other threads get ranges to work on as early as possible
+        size_t index = positions_.size();
+        for (size_t i = 0; i < positions_.size(); i++) {
+            if (positions_[i].done) continue;
+            if (states_[i] == RangeState::Unsplit) {
+                index = i;
+                break;
+            }
+            if (states_[i] == RangeState::Pending && index == positions_.size()) index = i;
+        }
+
+        if (index == positions_.size()) {
+            if (activeSplits_ == 0) break;  // No more work
+            workAvailable_.wait(lock);       // Splitting may publish more ranges
+            continue;
+        }
+
+        if (states_[index] == RangeState::Unsplit) {
+            states_[index] = RangeState::Splitting;
+            activeSplits_++;
+            lock.unlock();
+            splitRange(index);
+            lock.lock();
+            states_[index] = RangeState::Pending;  // The remaining tail of the range
+            activeSplits_--;
+            workAvailable_.notify_all();
+            continue;
+        }
+
+        states_[index] = RangeState::Active;
+        ValidationPosition position = positions_[index];
+        lock.unlock();
+        while (!position.done && !stopRequested_) {
+            position.done = validateBatch(position);
+            std::lock_guard<std::mutex> positionLock(mutex_);
+            positions_[index] = position;
+        }
+        lock.lock();
+    }
+}
+
+void BackgroundValidation::splitRange(size_t index) {
+    ValidationPosition tail;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tail = positions_[index];
+    }
+    try {
+        obx_id lastId = tail.lastId;
+        size_t idsInRange = 0;
+        while (!stopRequested_) {  // Iterates over IDs in bounded read transactions
+            CursorTx cursor(TxMode::READ, store_, tail.typeId);
+            obx_id id = seekToIdAfter(cursor, lastId);
+            for (size_t visited = 0; id != 0 && visited < maxObjectsPerTx_; visited++) {
+                lastId = id;
+                if (++idsInRange == objectsPerRange_) {  // Publish (tail.lastId, id] and continue after it
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        positions_.push_back({tail.typeId, tail.lastId, false, id});
+                        states_.push_back(RangeState::Pending);
+                        positions_[index].lastId = id;
+                    }
+                    workAvailable_.notify_one();
+                    tail.lastId = id;
+                    idsInRange = 0;
+                }
+                id = cursor.seekToNextId();
+            }
+            if (id == 0) break;
+        }
+    } catch (const Exception&) {
+        // Leaves the remaining tail unsplit; validating it reports the issue
+    }
+}
+
+bool BackgroundValidation::validateBatch(ValidationPosition& position) {
+    try {
+        CursorTx cursor(TxMode::READ, store_, position.typeId);
+        obx_id id = seekToIdAfter(cursor, position.lastId);
+        for (size_t visited = 0; id != 0; id = cursor.seekToNextId()) {
+            if (position.endId != 0 && id > position.endId) break;
+            if (isSampled(id)) {
+                const void* data = nullptr;
+                size_t size = 0;
+                obx_err err = obx_cursor_current(cursor.cPtr(), &data, &size);
+                if (err != OBX_SUCCESS) {
+                    reportIssue({position.typeId, id, err, obx_last_error_message()});
+                } else if (!passesStructureCheck(data, size)) {
+                    reportIssue({position.typeId, id, OBX_SUCCESS, "Object failed the structure check (root table)"});
+                }
+                checkedCount_.fetch_add(1, std::memory_order_relaxed);
+            }
+            position.lastId = id;
+            if (++visited == maxObjectsPerTx_) return false;  // Continue in a new transaction
+        }
+    } catch (const Exception& e) {  // E.g. reading failed: stop validating this range
+        reportIssue({position.typeId, 0, e.code(), e.what()});
+    }
+    return true;
+}
+
+obx_id BackgroundValidation::seekToIdAfter(CursorTx& cursor, obx_id lastId) {
+    if (lastId == 0) return cursor.seekToFirstId();
+    if (obx_cursor_seek(cursor.cPtr(), lastId) == OBX_SUCCESS) return cursor.seekToNextId();
+
+    // The object was removed meanwhile: skip to the first ID after it
+    obx_id id = cursor.seekToFirstId();
+    while (id != 0 && id <= lastId) id = cursor.seekToNextId();
+    return id;
+}
+
+bool BackgroundValidation::isSampled(obx_id id) const {
+    if (sampleRate_ >= 1.0) return true;
+    uint64_t hash = id * 0x9E3779B97F4A7C15ull;  // Fibonacci hashing: spreads consecutive IDs evenly
+    return static_cast<double>(hash >> 11) < sampleRate_ * static_cast<double>(uint64_t(1) << 53);
+}
+
+bool BackgroundValidation::passesStructureCheck(const void* data, size_t size) {
+#ifndef OBX_DISABLE_FLATBUFFERS
+    if (data == nullptr) return false;  // Bounds are checked by the verifier
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    flatbuffers::Verifier verifier(bytes, size, 64, 1000000, false);
+    size_t rootOffset = verifier.VerifyOffset(0);
+    return rootOffset != 0 && verifier.VerifyTableStart(bytes + rootOffset);
+#else
+    return data != nullptr && size > 0;
+#endif
+}
+
+void BackgroundValidation::reportIssue(ValidationIssue issue) {
+    issueCount_.fetch_add(1, std::memory_order_relaxed);
+    if (issueListener_) issueListener_(issue);
+}
+#endif  // OBX_CPP_FILE
+
+/// \brief Notifies about the completion of async operations (e.g. AsyncBox::put()) via callbacks or futures.
+///
+/// The async queue processes operations in the background and does not report on individual operations.
+/// AsyncCompletion provides completion tokens instead: a callback (or future) registered right after submitting
+/// operations is notified once those operations were processed; unlike AsyncBox::awaitCompletion(), this does not
+/// wait for operations submitted later. A background thread waits (via obx_store_await_async_submitted()) for all
+/// operations submitted before the callbacks were registered; callbacks registered meanwhile are grouped.
+/// Note: the status refers to the async queue, i.e. OBX_SUCCESS if it processed the operations; an individual
+/// operation may still have failed (e.g. a unique constraint violation), which is logged by the async queue.
+/// Callbacks are called on the background thread and should return quickly.
+class AsyncCompletion {
+    OBX_store* cStore_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::vector<AsyncStatusCallback> waiting_;
+    bool stopping_ = false;
+    std::thread thread_;
+
+public:
+    explicit AsyncCompletion(Store& store);
+
+    /// Processes the remaining callbacks (waits for their operations) before returning.
+    virtual ~AsyncCompletion();
+
+    /// Can't be copied or moved: the background thread refers to it
+    AsyncCompletion(const AsyncCompletion&) = delete;
+
+    /// Calls the given callback once all async operations submitted before this call were processed.
+    /// @param callback receives OBX_SUCCESS or an error code, e.g. if the store is shutting down.
+    void onProcessed(AsyncStatusCallback callback);
+
+    /// A completion token for all async operations submitted before this call.
+    /// @returns a future that becomes ready once those operations were processed; throws if the queue failed.
+    std::future<void> processed();
+
+#ifndef OBX_DISABLE_FLATBUFFERS
+    /// Puts the given object asynchronously (see AsyncBox::put()) and tracks its completion.
+    /// @returns a future providing the object ID once the async queue processed the put.
+    template <typename EntityT>
+    std::future<obx_id> put(AsyncBox<EntityT>& asyncBox, EntityT& object, OBXPutMode mode = OBXPutMode_PUT) {
+        return idFuture(asyncBox.put(object, mode));
+    }
+
+    /// Puts the given object using the box's shared AsyncBox and tracks its completion; see put(AsyncBox&, ...).
+    template <typename EntityT>
+    std::future<obx_id> put(Box<EntityT>& box, EntityT& object, OBXPutMode mode = OBXPutMode_PUT) {
+        AsyncBox<EntityT> asyncBox = box.async();
+        return put(asyncBox, object, mode);
+    }
+#endif
+
+    /// Removes the object with the given ID asynchronously (see AsyncBox::remove()) and tracks its completion.
+    template <typename EntityT>
+    std::future<void> remove(AsyncBox<EntityT>& asyncBox, obx_id id) {
+        asyncBox.remove(id);
+        return processed();
+    }
+
+private:
+    std::future<obx_id> idFuture(obx_id id);
+
+    void run();
+};
+
+#ifdef OBX_CPP_FILE
+namespace {
+std::exception_ptr asyncStatusException(obx_err status) {
+    try {
+        internal::throwError(status, "Async operations were not processed (shutting down or an error occurred)");
+    } catch (...) {
+        return std::current_exception();
+    }
+}
+}  // namespace
+
+AsyncCompletion::AsyncCompletion(Store& store) : cStore_(store.cPtr()) {
+    thread_ = std::thread(&AsyncCompletion::run, this);  // Last: may throw, e.g. if no more threads are available
+}
+
+AsyncCompletion::~AsyncCompletion() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+void AsyncCompletion::onProcessed(AsyncStatusCallback callback) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) throw ShuttingDownException("AsyncCompletion is being destroyed");
+        waiting_.push_back(std::move(callback));
+    }
+    condition_.notify_one();
+}
+
+std::future<void> AsyncCompletion::processed() {
+    std::shared_ptr<std::promise<void>> promise = std::make_shared<std::promise<void>>();
+    std::future<void> future = promise->get_future();
+    onProcessed([promise](obx_err status) {
+        if (status == OBX_SUCCESS) {
+            promise->set_value();
+        } else {
+            promise->set_exception(asyncStatusException(status));
+        }
+    });
+    return future;
+}
+
+std::future<obx_id> AsyncCompletion::idFuture(obx_id id) {
+    std::shared_ptr<std::promise<obx_id>> promise = std::make_shared<std::promise<obx_id>>();
+    std::future<obx_id> future = promise->get_future();
+    onProcessed([promise, id](obx_err status) {
+        if (status == OBX_SUCCESS) {
+            promise->set_value(id);
+        } else {
+            promise->set_exception(asyncStatusException(status));
+        }
+    });
+    return future;
+}
+
+void AsyncCompletion::run() {
+    std::vector<AsyncStatusCallback> callbacks;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this]() { return stopping_ || !waiting_.empty(); });
+        if (waiting_.empty()) return;  // Stopping and nothing left to do
+        callbacks.swap(waiting_);
+        lock.unlock();
+
+        // All operations of the callbacks were submitted before the callbacks were taken (and thus before this call)
+        obx_err status = OBX_SUCCESS;
+        if (!obx_store_await_async_submitted(cStore_)) {
+            status = obx_last_error_code() != OBX_SUCCESS ? obx_last_error_code() : OBX_ERROR_SHUTTING_DOWN;
+        }
+        for (AsyncStatusCallback& callback : callbacks) {
+            try {
+                callback(status);
+            } catch (...) {
+                // A throwing callback must not stop the notification of the others
+            }
+        }
+        callbacks.clear();
+        lock.lock();
+    }
+}
+#endif  // OBX_CPP_FILE
+
+/// Live values of an AsyncWriteController, e.g. to be graphed.
+struct AsyncWriteStats {
+    size_t window;             ///< Current max. number of outstanding (submitted, not yet processed) operations
+    size_t outstanding;        ///< Operations submitted but not yet processed
+    uint64_t latencyMicros;    ///< Smoothed latency from submission until processed (exponential moving average)
+    uint64_t completed;        ///< Operations processed since creation
+    uint64_t failed;           ///< Operations whose queue status was not OBX_SUCCESS
+    uint64_t throttled;        ///< Submissions that had to wait because the window was full
+    uint64_t throttledMicros;  ///< Total time submissions waited because the window was full
+};
+
+/// \brief Adapts the rate of async operations to a target latency (time from submission until processed).
+///
+/// The async queue options (e.g. Options::asyncThrottleAtQueueLength()) are fixed once the store is opened, but the
+/// right values change with the load. This controller limits the number of outstanding operations ("window")
+/// submitted through it and adapts that window continuously (AIMD): it grows additively by one per window's worth of
+/// completions (i.e. about once per latency period) while the measured latency stays below the target, and shrinks
+/// multiplicatively (at most once per latency period) if the target is exceeded.
+/// Submissions exceeding the window wait until operations were processed (throttling at the source).
+/// Use stats() to observe the live values. Thread-safe; completion is measured using an AsyncCompletion.
+class AsyncWriteController {
+    std::chrono::microseconds targetLatency_;
+    size_t minWindow_;
+    size_t maxWindow_;
+
+    std::mutex mutex_;
+    std::condition_variable windowCondition_;
+    AsyncWriteStats stats_;
+    size_t growthCompletions_ = 0;  ///< Completions below the target latency since the window last changed
+    std::chrono::steady_clock::time_point lastDecrease_;
+    AsyncCompletion completion_;  // Last member: its thread calls back into this object until it is destroyed
+
+public:
+    /// @param targetLatency the latency to stay below (from submitting an operation until it was processed)
+    /// @param minWindow the minimum number of outstanding operations (the window never shrinks below this)
+    /// @param maxWindow the maximum number of outstanding operations; consider Options::asyncMaxQueueLength()
+    AsyncWriteController(Store& store, std::chrono::microseconds targetLatency, size_t minWindow = 16,
+                         size_t maxWindow = 10000);
+
+#ifndef OBX_DISABLE_FLATBUFFERS
+    /// Puts the given object asynchronously (see AsyncBox::put()); waits first if the window is full.
+    /// @return the reserved ID which will be used for the object if the asynchronous put succeeds.
+    template <typename EntityT>
+    obx_id put(AsyncBox<EntityT>& asyncBox, EntityT& object, OBXPutMode mode = OBXPutMode_PUT) {
+        std::chrono::steady_clock::time_point submitTime = acquire();
+        obx_id id;
+        try {
+            id = asyncBox.put(object, mode);
+        } catch (...) {
+            release();
+            throw;
+        }
+        track(submitTime);
+        return id;
+    }
+#endif
+
+    /// Removes the object with the given ID asynchronously (see AsyncBox::remove()); waits first if the window is full.
+    template <typename EntityT>
+    void remove(AsyncBox<EntityT>& asyncBox, obx_id id) {
+        std::chrono::steady_clock::time_point submitTime = acquire();
+        try {
+            asyncBox.remove(id);
+        } catch (...) {
+            release();
+            throw;
+        }
+        track(submitTime);
+    }
+
+    /// A snapshot of the current values.
+    AsyncWriteStats stats();
+
+private:
+    /// Waits for a free slot in the window and takes it; returns the submission time.
+    std::chrono::steady_clock::time_point acquire();
+
+    /// Gives back a slot taken by acquire() for an operation that could not be submitted.
+    void release();
+
+    /// Registers the completion of a submitted operation to measure its latency and adapt the window.
+    void track(std::chrono::steady_clock::time_point submitTime);
+
+    void completed(std::chrono::steady_clock::time_point submitTime, obx_err status);
+};
+
+#ifdef OBX_CPP_FILE
+AsyncWriteController::AsyncWriteController(Store& store, std::chrono::microseconds targetLatency, size_t minWindow,
+                                           size_t maxWindow)
+    : targetLatency_(targetLatency), minWindow_(minWindow), maxWindow_(maxWindow), stats_(), completion_(store) {
+    if (minWindow == 0 || minWindow > maxWindow) {
+        throw IllegalArgumentException("Window sizes must satisfy 0 < minWindow <= maxWindow");
+    }
+    stats_.window = minWindow;
+}
+
+AsyncWriteStats AsyncWriteController::stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+std::chrono::steady_clock::time_point AsyncWriteController::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stats_.outstanding >= stats_.window) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        windowCondition_.wait(lock, [this]() { return stats_.outstanding < stats_.window; });
+        std::chrono::steady_clock::duration waited = std::chrono::steady_clock::now() - start;
+        stats_.throttled++;
+        stats_.throttledMicros += std::chrono::duration_cast<std::chrono::microseconds>(waited).count();
+    }
+    stats_.outstanding++;
+    return std::chrono::steady_clock::now();
+}
+
+void AsyncWriteController::release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.outstanding--;
+    }
+    windowCondition_.notify_one();
+}
+
+void AsyncWriteController::track(std::chrono::steady_clock::time_point submitTime) {
+    try {
+        completion_.onProcessed([this, submitTime](obx_err status) { completed(submitTime, status); });
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+void AsyncWriteController::completed(std::chrono::steady_clock::time_point submitTime, obx_err status) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    uint64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(now - submitTime).count();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.outstanding--;
+        stats_.completed++;
+        if (status != OBX_SUCCESS) stats_.failed++;
+        stats_.latencyMicros = stats_.completed == 1 ? latency : (stats_.latencyMicros * 7 + latency) / 8;
+
+        if (stats_.latencyMicros > static_cast<uint64_t>(targetLatency_.count())) {
+            // Shrink once per latency period; completions of the same period reflect the same (old) window
+            if (now - lastDecrease_ > std::chrono::microseconds(stats_.latencyMicros)) {
+                stats_.window = std::max(minWindow_, stats_.window * 3 / 4);
+                lastDecrease_ = now;
+                growthCompletions_ = 0;
+            }
+        } else if (stats_.window < maxWindow_ && ++growthCompletions_ >= stats_.window) {
+            stats_.window++;  // Additive increase: +1 per window's worth of completions
+            growthCompletions_ = 0;
+        }
+    }
+    windowCondition_.notify_all();
+}
+#endif  // OBX_CPP_FILE
+
+/// \brief Calculates vector distances using the distance functions of the vector search (HNSW index), e.g. to re-rank
+/// results or to compare vectors outside of queries.
+///
+/// Besides single distances, this provides batch variants: one-vs-many is a convenience loop over single distances;
+/// many-vs-many compares blocks of vectors that fit into the CPU cache against all rows and can use multiple threads.
+class VectorDistance {
+    OBXVectorDistanceType type_;
+
+public:
+    /// @throws IllegalStateException if the vector search feature is not available
+    explicit VectorDistance(OBXVectorDistanceType type);
+
+    OBXVectorDistanceType type() const { return type_; }
+
+    /// Distance of the two given vectors (with the given number of elements each); lower is nearer.
+    float operator()(const float* vector1, const float* vector2, size_t dimensions) const {
+        return obx_vector_distance_float32(type_, vector1, vector2, dimensions);
+    }
+
+    /// Converts a distance (e.g. a query score) of this distance type to a relevance between 0.0 and 1.0 (nearest).
+    float toRelevance(float distance) const { return obx_vector_distance_to_relevance(type_, distance); }
+
+    /// Calculates the distances of one vector to many vectors.
+    /// @param vectors count vectors with the given number of elements each, stored one after another
+    /// @param outDistances receives count distances; index-matching the given vectors
+    void oneToMany(const float* vector, const float* vectors, size_t count, size_t dimensions,
+                   float* outDistances) const;
+
+    /// Calculates the distances of one vector to many vectors; see the pointer-based variant for details.
+    std::vector<float> oneToMany(const float* vector, const float* vectors, size_t count, size_t dimensions) const {
+        std::vector<float> distances(count);
+        oneToMany(vector, vectors, count, dimensions, distances.data());
+        return distances;
+    }
+
+    /// Calculates the distance matrix of two sets of vectors (each vector with the given number of elements).
+    /// @param outMatrix receives countA * countB distances in row-major order, i.e. the distance of vectorsA[i] and
+    ///        vectorsB[j] is at outMatrix[i * countB + j]
+    /// @param threadCount the number of threads (including the calling thread) sharing the rows of the matrix
+    void manyToMany(const float* vectorsA, size_t countA, const float* vectorsB, size_t countB, size_t dimensions,
+                    float* outMatrix, size_t threadCount = 1) const;
+};
+
+#ifdef OBX_CPP_FILE
+VectorDistance::VectorDistance(OBXVectorDistanceType type) : type_(type) {
+    if (!obx_has_feature(OBXFeature_VectorSearch)) {
+        throw IllegalStateException("Vector distances require the vector search feature, which is unavailable");
+    }
+}
+
+void VectorDistance::oneToMany(const float* vector, const float* vectors, size_t count, size_t dimensions,
+                               float* outDistances) const {
+    for (size_t i = 0; i < count; i++) {
+        outDistances[i] = obx_vector_distance_float32(type_, vector, vectors + i * dimensions, dimensions);
+    }
+}
+
+void VectorDistance::manyToMany(const float* vectorsA, size_t countA, const float* vectorsB, size_t countB,
+                                size_t dimensions, float* outMatrix, size_t threadCount) const {
+    // Blocks of vectorsB sized to stay in the CPU cache (~128 KB) while all rows (vectorsA) are compared against them
+    const size_t blockSize = std::max(size_t(1), (128 * 1024) / (std::max(dimensions, size_t(1)) * sizeof(float)));
+    internal::parallelChunks(countA, threadCount, [&](size_t beginA, size_t endA) {
+        for (size_t blockBegin = 0; blockBegin < countB; blockBegin += blockSize) {
+            size_t blockEnd = std::min(countB, blockBegin + blockSize);
+            for (size_t a = beginA; a < endA; a++) {
+                const float* vectorA = vectorsA + a * dimensions;
+                float* row = outMatrix + a * countB;
+                for (size_t b = blockBegin; b < blockEnd; b++) {
+                    row[b] = obx_vector_distance_float32(type_, vectorA, vectorsB + b * dimensions, dimensions);
+                }
+            }
+        }
+    });
+}
+#endif  // OBX_CPP_FILE
+
+/// Compression scheme used by QuantizedVectorIndex.
+enum class VectorQuantization {
+    /// Scalar quantization: each dimension is mapped to 8 bits (4x less memory than float32) using the dimension's
+    /// minimum and a scale shared by all dimensions (the largest value range), so that distances are computed on the
+    /// 8-bit codes directly (integer arithmetic) for Euclidean, Manhattan and dot product based distance types.
+    Int8,
+
+    /// Binary quantization: each dimension is reduced to 1 bit (above or below the dimension's mean; 32x less memory).
+    /// Candidates are ranked by Hamming distance, thus re-ranking with the exact vectors is strongly recommended.
+    Binary
+};
+
+/// A vector search result: the object ID and its distance to the query vector (lower is nearer).
+struct VectorSearchResult {
+    obx_id id;
+    float distance;
+};
+
+/// \brief In-memory vector index keeping compressed (quantized) copies of float32 vectors.
+///
+/// Intended for large vector sets whose float32 HNSW vector cache does not fit into RAM: the compressed vectors are
+/// scanned to find the nearest candidates, which can then be re-ranked using the exact float32 vectors (e.g. read
+/// from the objects). The recall is configurable via the candidate count used for re-ranking.
+/// Note: this is a flat (exhaustive) index; its search time grows linearly with the number of vectors.
+/// Adding vectors is not thread-safe; concurrent searches (const methods) are fine once the index is filled.
+class QuantizedVectorIndex {
+    VectorQuantization quantization_;
+    size_t dimensions_;
+    OBXVectorDistanceType distanceType_;
+    size_t codeSize_;             ///< Bytes per encoded vector
+    std::vector<float> offsets_;  ///< Int8: per dimension minimum; Binary: per dimension mean
+    float scale_ = 1.0f;          ///< Int8 only: largest (max - min) / 255 of all dimensions
+    float offsetSquares_ = 0;     ///< Int8 only: sum of offset * offset
+    std::vector<obx_id> ids_;
+    std::vector<uint8_t> codes_;       ///< Encoded vectors, codeSize_ bytes each, in the order of ids_
+    std::vector<float> offsetDots_;    ///< Int8 dot product types only: per vector sum of offset * code
+    std::vector<float> squaredNorms_;  ///< Int8 dot product types only: per vector squared length (decoded)
+
+public:
+    /// @param distanceType used for Int8 candidates and for re-ranking; Binary candidates use Hamming distance.
+    QuantizedVectorIndex(VectorQuantization quantization, size_t dimensions,
+                         OBXVectorDistanceType distanceType = OBXVectorDistanceType_Euclidean);
+
+    VectorQuantization quantization() const { return quantization_; }
+
+    size_t dimensions() const { return dimensions_; }
+
+    size_t size() const { return ids_.size(); }
+
+    /// Approximate memory used by the index (encoded vectors, IDs and quantization parameters) in bytes.
+    size_t memoryBytes() const;
+
+    /// Derives the quantization parameters (per dimension ranges or means) from the given sample vectors.
+    /// Must be called before adding vectors; a representative sample is enough; re-training clears the index.
+    /// @param vectors count * dimensions() values, i.e. the vectors are stored one after another.
+    void train(const float* vectors, size_t count);
+
+    /// Encodes and adds the given vector; values outside of the trained range are clamped.
+    void add(obx_id id, const float* vector);
+
+    /// Convenience to add multiple vectors stored one after another (count * dimensions() values).
+    void add(const std::vector<obx_id>& ids, const float* vectors);
+
+    /// Finds the nearest neighbors using the compressed vectors only.
+    /// @returns up to maxResultCount results, nearest first; distances are approximations (Hamming for Binary).
+    std::vector<VectorSearchResult> search(const float* query, size_t maxResultCount) const;
+
+    /// Finds candidates using the compressed vectors and re-ranks them using the exact float32 vectors.
+    /// @param candidateCount number of candidates to re-rank (at least maxResultCount); higher values improve recall.
+    /// @param exactVector provides the float32 vector (dimensions() values) for an ID; may return nullptr to skip it.
+    ///        The returned pointer must stay valid until the next call; e.g. use a read transaction and ObjectView.
+    /// @returns up to maxResultCount results with exact distances, nearest first.
+    std::vector<VectorSearchResult> search(const float* query, size_t maxResultCount, size_t candidateCount,
+                                           const std::function<const float*(obx_id id)>& exactVector) const;
+
+private:
+    void encode(const float* vector, uint8_t* outCode) const;
+
+    /// Int8 only: whether the distances are based on the dot product (see offsetDots_).
+    bool usesDotProduct() const;
+
+    /// Int8 only: sum of offset * code for the given code.
+    float offsetDot(const uint8_t* code) const;
+};
+
+#ifdef OBX_CPP_FILE
+namespace {
+// Function objects (not function pointers) to let the compiler inline and vectorize them in int8Sum()
+struct Int8SquaredDifference {
+    uint32_t operator()(uint32_t a, uint32_t b) const {
+        int32_t difference = static_cast<int32_t>(a) - static_cast<int32_t>(b);
+        return static_cast<uint32_t>(difference * difference);
+    }
+};
+
+struct Int8AbsoluteDifference {
+    uint32_t operator()(uint32_t a, uint32_t b) const { return a > b ? a - b : b - a; }
+};
+
+struct Int8Product {
+    uint32_t operator()(uint32_t a, uint32_t b) const { return a * b; }
+};
+
+/// Sums op(a[i], b[i]) of 8-bit codes; the inner loop uses 32-bit accumulators, which compilers vectorize well.
+/// Blocks of 2^16 elements keep the accumulator from overflowing (255 * 255 * 2^16 < 2^32).
+template <typename Op>
+uint64_t int8Sum(const uint8_t* a, const uint8_t* b, size_t size, Op op) {
+    uint64_t sum = 0;
+    for (size_t begin = 0; begin < size; begin += 65536) {
+        size_t end = std::min(size, begin + 65536);
+        uint32_t blockSum = 0;
+        for (size_t i = begin; i < end; i++) blockSum += op(a[i], b[i]);
+        sum += blockSum;
+    }
+    return sum;
+}
+}  // namespace
+
+QuantizedVectorIndex::QuantizedVectorIndex(VectorQuantization quantization, size_t dimensions,
+                                           OBXVectorDistanceType distanceType)
+    : quantization_(quantization),
+      dimensions_(dimensions),
+      distanceType_(distanceType),
+      codeSize_(quantization == VectorQuantization::Int8 ? dimensions : (dimensions + 7) / 8) {
+    if (dimensions == 0) throw IllegalArgumentException("Vector dimensions must be greater than zero");
+}
+
+size_t QuantizedVectorIndex::memoryBytes() const {
+    return codes_.size() + ids_.size() * sizeof(obx_id) +
+           (offsets_.size() + offsetDots_.size() + squaredNorms_.size()) * sizeof(float);
+}
+
+void QuantizedVectorIndex::train(const float* vectors, size_t count) {
+    if (count == 0) throw IllegalArgumentException("At least one vector is required for training");
+    ids_.clear();
+    codes_.clear();
+    offsetDots_.clear();
+    squaredNorms_.clear();
+    offsets_.assign(dimensions_, 0.0f);
+    if (quantization_ == VectorQuantization::Int8) {
+        std::vector<float> maxValues(vectors, vectors + dimensions_);
+        offsets_.assign(vectors, vectors + dimensions_);
+        for (size_t i = 1; i < count; i++) {
+            const float* vector = vectors + i * dimensions_;
+            for (size_t d = 0; d < dimensions_; d++) {
+                offsets_[d] = std::min(offsets_[d], vector[d]);
+                maxValues[d] = std::max(maxValues[d], vector[d]);
+            }
+        }
+        float maxRange = 0;
+        offsetSquares_ = 0;
+        for (size_t d = 0; d < dimensions_; d++) {
+            maxRange = std::max(maxRange, maxValues[d] - offsets_[d]);
+            offsetSquares_ += offsets_[d] * offsets_[d];
+        }
+        scale_ = maxRange > 0 ? maxRange / 255.0f : 1.0f;
+    } else {
+        std::vector<double> sums(dimensions_, 0.0);
+        for (size_t i = 0; i < count; i++) {
+            const float* vector = vectors + i * dimensions_;
+            for (size_t d = 0; d < dimensions_; d++) sums[d] += vector[d];
+        }
+        for (size_t d = 0; d < dimensions_; d++) offsets_[d] = static_cast<float>(sums[d] / count);
+    }
+}
+
+void QuantizedVectorIndex::add(obx_id id, const float* vector) {
+    if (offsets_.empty()) throw IllegalStateException("The index must be trained before adding vectors");
+    size_t offset = codes_.size();
+    codes_.resize(offset + codeSize_);
+    uint8_t* code = codes_.data() + offset;
+    encode(vector, code);
+    ids_.push_back(id);
+    if (quantization_ == VectorQuantization::Int8 && usesDotProduct()) {
+        float squaredNorm = 0;
+        for (size_t d = 0; d < dimensions_; d++) {
+            float decoded = offsets_[d] + code[d] * scale_;
+            squaredNorm += decoded * decoded;
+        }
+        offsetDots_.push_back(offsetDot(code));
+        squaredNorms_.push_back(squaredNorm);
+    }
+}
+
+void QuantizedVectorIndex::add(const std::vector<obx_id>& ids, const float* vectors) {
+    ids_.reserve(ids_.size() + ids.size());
+    codes_.reserve(codes_.size() + ids.size() * codeSize_);
+    for (size_t i = 0; i < ids.size(); i++) add(ids[i], vectors + i * dimensions_);
+}
+
+void QuantizedVectorIndex::encode(const float* vector, uint8_t* outCode) const {
+    if (quantization_ == VectorQuantization::Int8) {
+        for (size_t d = 0; d < dimensions_; d++) {
+            float scaled = (vector[d] - offsets_[d]) / scale_ + 0.5f;
+            outCode[d] = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, scaled)));
+        }
+    } else {
+        memset(outCode, 0, codeSize_);
+        for (size_t d = 0; d < dimensions_; d++) {
+            if (vector[d] > offsets_[d]) outCode[d / 8] |= static_cast<uint8_t>(1u << (d % 8));
+        }
+    }
+}
+
+bool QuantizedVectorIndex::usesDotProduct() const {
+    return distanceType_ == OBXVectorDistanceType_Cosine || distanceType_ == OBXVectorDistanceType_DotProduct ||
+           distanceType_ == OBXVectorDistanceType_DotProductNonNormalized;
+}
+
+float QuantizedVectorIndex::offsetDot(const uint8_t* code) const {
+    float sum = 0;
+    for (size_t d = 0; d < dimensions_; d++) sum += offsets_[d] * code[d];
+    return sum;
+}
+
+std::vector<VectorSearchResult> QuantizedVectorIndex::search(const float* query, size_t maxResultCount) const {
+    std::vector<VectorSearchResult> results;
+    if (maxResultCount == 0 || ids_.empty()) return results;
+    auto nearerFirst = [](const VectorSearchResult& a, const VectorSearchResult& b) { return a.distance < b.distance; };
+
+    // Keep the best maxResultCount results as a max-heap, so the farthest one is cheap to check and to replace
+    results.reserve(maxResultCount);
+    auto offer = [&](size_t index, float distance) {
+        if (results.size() < maxResultCount) {
+            results.push_back({ids_[index], distance});
+            std::push_heap(results.begin(), results.end(), nearerFirst);
+        } else if (distance < results.front().distance) {
+            std::pop_heap(results.begin(), results.end(), nearerFirst);
+            results.back() = {ids_[index], distance};
+            std::push_heap(results.begin(), results.end(), nearerFirst);
+        }
+    };
+
+    if (quantization_ == VectorQuantization::Int8) {
+        // The query is quantized once; with value = offset + scale * code, the distances follow from integer sums
+        std::vector<uint8_t> queryCode(codeSize_);
+        encode(query, queryCode.data());
+        const uint8_t* q = queryCode.data();
+        const float scale = scale_;
+        if (usesDotProduct()) {
+            // dot = sum(offset^2) + scale * (sum(offset * code) + sum(offset * qCode)) + scale^2 * sum(code * qCode)
+            const float queryOffsetDot = offsetDot(q);
+            const float queryConstant = offsetSquares_ + scale * queryOffsetDot;
+            float querySquaredNorm = 0;
+            for (size_t d = 0; d < dimensions_; d++) {
+                float decoded = offsets_[d] + q[d] * scale;
+                querySquaredNorm += decoded * decoded;
+            }
+            for (size_t i = 0; i < ids_.size(); i++) {
+                uint64_t codeDot = int8Sum(codes_.data() + i * codeSize_, q, codeSize_, Int8Product());
+                float dot = queryConstant + scale * offsetDots_[i] + scale * scale * static_cast<float>(codeDot);
+                if (distanceType_ == OBXVectorDistanceType_Cosine) {
+                    float norms = std::sqrt(squaredNorms_[i] * querySquaredNorm);
+                    dot = norms > 0 ? dot / norms : 0;
+                }
+                offer(i, 1.0f - dot);  // Lower is nearer; for DotProductNonNormalized, only the order is preserved
+            }
+        } else if (distanceType_ == OBXVectorDistanceType_Manhattan) {
+            for (size_t i = 0; i < ids_.size(); i++) {
+                uint64_t sum = int8Sum(codes_.data() + i * codeSize_, q, codeSize_, Int8AbsoluteDifference());
+                offer(i, scale * static_cast<float>(sum));
+            }
+        } else {  // Euclidean (squared); also used to rank candidates for other distance types
+            for (size_t i = 0; i < ids_.size(); i++) {
+                uint64_t sum = int8Sum(codes_.data() + i * codeSize_, q, codeSize_, Int8SquaredDifference());
+                offer(i, scale * scale * static_cast<float>(sum));
+            }
+        }
+    } else {
+        std::vector<uint8_t> queryCode(codeSize_);
+        encode(query, queryCode.data());
+        for (size_t i = 0; i < ids_.size(); i++) {
+            const uint8_t* code = codes_.data() + i * codeSize_;
+            size_t bits = 0;
+            size_t b = 0;
+            for (; b + sizeof(uint64_t) <= codeSize_; b += sizeof(uint64_t)) {
+                uint64_t x;
+                uint64_t y;
+                memcpy(&x, code + b, sizeof(uint64_t));
+                memcpy(&y, queryCode.data() + b, sizeof(uint64_t));
+                bits += std::bitset<64>(x ^ y).count();
+            }
+            for (; b < codeSize_; b++) bits += std::bitset<8>(code[b] ^ queryCode[b]).count();
+            offer(i, static_cast<float>(bits));
+        }
+    }
+    std::sort_heap(results.begin(), results.end(), nearerFirst);
+    return results;
+}
+
+std::vector<VectorSearchResult> QuantizedVectorIndex::search(
+    const float* query, size_t maxResultCount, size_t candidateCount,
+    const std::function<const float*(obx_id id)>& exactVector) const {
+    std::vector<VectorSearchResult> results = search(query, std::max(maxResultCount, candidateCount));
+    size_t count = 0;
+    for (const VectorSearchResult& candidate : results) {
+        const float* vector = exactVector(candidate.id);
+        if (vector == nullptr) continue;
+        results[count++] = {candidate.id, obx_vector_distance_float32(distanceType_, query, vector, dimensions_)};
+    }
+    results.resize(count);
+    std::sort(results.begin(), results.end(),
+              [](const VectorSearchResult& a, const VectorSearchResult& b) { return a.distance < b.distance; });
+    if (results.size() > maxResultCount) results.resize(maxResultCount);
+    return results;
+}
+#endif  // OBX_CPP_FILE
+
+#ifndef OBX_DISABLE_FLATBUFFERS
+
+/// \brief Nearest neighbor search restricted to objects matching a filter, e.g. all objects of one tenant.
+///
+/// A query combining a nearest neighbor condition with other conditions applies those conditions to the neighbors
+/// found via the HNSW index. Thus, selective filters leave too few results unless the max result count is raised a lot.
+/// This class adapts to the filter's selectivity for each search:
+/// - If only a few objects match (see bruteForceThreshold()), their vectors are compared directly (exact results).
+/// - Otherwise, the HNSW search fetches neighbors in proportion to the filter's selectivity (see overfetchFactor())
+///   and doubles that count until enough neighbors passed the filter.
+/// Note: each search queries the objects matching the filter (up to bruteForceThreshold() IDs, or their count);
+/// consider an index on the filtered properties.
+template <typename EntityT>
+class FilteredVectorSearch {
+    using EntityBinding = typename EntityT::_OBX_MetaInfo;
+
+    Store& store_;
+    Box<EntityT> box_;
+    Property<EntityT, OBXPropertyType_FloatVector> vectorProperty_;
+    OBXVectorDistanceType distanceType_;
+    size_t bruteForceThreshold_ = 10000;
+    double overfetchFactor_ = 2.0;
+
+public:
+    /// @param distanceType must match the distance type of the property's HNSW index
+    FilteredVectorSearch(Store& store, Property<EntityT, OBXPropertyType_FloatVector> vectorProperty,
+                         OBXVectorDistanceType distanceType = OBXVectorDistanceType_Euclidean)
+        : store_(store), box_(store), vectorProperty_(vectorProperty), distanceType_(distanceType) {}
+
+    /// Filters matching at most this many objects are searched by brute force instead of the HNSW index (default
+    /// 10000). Brute force reads the vectors of all matching objects, but avoids HNSW searches with very high max
+    /// result counts.
+    FilteredVectorSearch& bruteForceThreshold(size_t maxMatchCount) {
+        bruteForceThreshold_ = maxMatchCount;
+        return *this;
+    }
+
+    /// Multiplies the initial HNSW max result count, which is derived from the filter's selectivity (default 2.0).
+    /// Higher values make repeated HNSW searches less likely and may improve the result quality.
+    FilteredVectorSearch& overfetchFactor(double factor) {
+        if (factor < 1.0) throw IllegalArgumentException("Overfetch factor must be at least 1");
+        overfetchFactor_ = factor;
+        return *this;
+    }
+
+    /// Finds the nearest neighbors among the objects matching the given filter condition.
+    /// @returns up to maxResultCount object IDs with their scores (distances), nearest first; like
+    ///          Query::findIdsWithScores().
+    std::vector<std::pair<obx_id, double>> findIdsWithScores(const std::vector<float>& queryVector,
+                                                             size_t maxResultCount, const QueryCondition& filter) {
+        // Only the IDs needed for brute force are found; above the threshold, the count suffices for the selectivity
+        Query<EntityT> query = box_.query(filter).build();
+        std::vector<obx_id> matchingIds = query.limit(bruteForceThreshold_ + 1).findIds();
+        if (matchingIds.size() <= bruteForceThreshold_) {
+            return bruteForce(queryVector, maxResultCount, matchingIds);
+        }
+        uint64_t matchCount = query.limit(0).count();
+        auto builder = [&]() { return box_.query(filter); };
+        auto accept = [](obx_id) { return true; };
+        return searchIndex(queryVector, maxResultCount, matchCount, builder, accept);
+    }
+
+    /// Finds the nearest neighbors among the objects with the given IDs, e.g. a precomputed set of allowed objects.
+    /// Duplicate IDs are ignored.
+    /// @returns up to maxResultCount object IDs with their scores (distances), nearest first; like
+    ///          Query::findIdsWithScores().
+    std::vector<std::pair<obx_id, double>> findIdsWithScores(const std::vector<float>& queryVector,
+                                                             size_t maxResultCount,
+                                                             const std::vector<obx_id>& allowedIds) {
+        std::vector<obx_id> sortedIds(allowedIds);
+        std::sort(sortedIds.begin(), sortedIds.end());
+        sortedIds.erase(std::unique(sortedIds.begin(), sortedIds.end()), sortedIds.end());
+        if (sortedIds.size() <= bruteForceThreshold_) {
+            return bruteForce(queryVector, maxResultCount, sortedIds);
+        }
+        auto builder = [&]() { return box_.query(); };
+        auto accept = [&](obx_id id) { return std::binary_search(sortedIds.begin(), sortedIds.end(), id); };
+        return searchIndex(queryVector, maxResultCount, sortedIds.size(), builder, accept);
+    }
+
+    /// Like findIdsWithScores(), but reads the resulting objects.
+    std::vector<std::pair<EntityT, double>> findWithScores(const std::vector<float>& queryVector,
+                                                           size_t maxResultCount, const QueryCondition& filter) {
+        return readObjects(findIdsWithScores(queryVector, maxResultCount, filter));
+    }
+
+    /// Like findIdsWithScores(), but reads the resulting objects.
+    std::vector<std::pair<EntityT, double>> findWithScores(const std::vector<float>& queryVector,
+                                                           size_t maxResultCount,
+                                                           const std::vector<obx_id>& allowedIds) {
+        return readObjects(findIdsWithScores(queryVector, maxResultCount, allowedIds));
+    }
+
+private:
+    static void sortAndTruncate(std::vector<std::pair<obx_id, double>>& results, size_t maxResultCount) {
+        auto nearerFirst = [](const std::pair<obx_id, double>& a, const std::pair<obx_id, double>& b) {
+            return a.second < b.second;
+        };
+        if (results.size() > maxResultCount) {
+            std::partial_sort(results.begin(), results.begin() + maxResultCount, results.end(), nearerFirst);
+            results.resize(maxResultCount);
+        } else {
+            std::sort(results.begin(), results.end(), nearerFirst);
+        }
+    }
+
+    /// Computes the distances to all given objects (unique IDs) in a single read transaction.
+    /// The vectors are read directly from the stored FlatBuffers bytes (like ObjectView), i.e. no objects are created.
+    /// @throws IllegalArgumentException if an object's vector dimensions differ from the query vector's
+    std::vector<std::pair<obx_id, double>> bruteForce(const std::vector<float>& queryVector, size_t maxResultCount,
+                                                      const std::vector<obx_id>& ids) {
+        std::vector<std::pair<obx_id, double>> results;
+        results.reserve(ids.size());
+
+        // FlatBuffers fields are stored in the order of the property IDs, i.e. the first property has offset 4
+        auto vtableOffset = static_cast<flatbuffers::voffset_t>(4 + 2 * (vectorProperty_.id() - 1));
+        CursorTx cursor(TxMode::READ, store_, EntityBinding::entityId());
+        const void* data;
+        size_t size;
+        for (size_t i : internal::idOrderAscending(ids)) {
+            obx_err err = obx_cursor_get(cursor.cPtr(), ids[i], &data, &size);
+            if (err == OBX_NOT_FOUND) continue;
+            internal::checkErrOrThrow(err);
+            const flatbuffers::Table* table = flatbuffers::GetRoot<flatbuffers::Table>(data);
+            auto vector = table->GetPointer<const flatbuffers::Vector<float>*>(vtableOffset);
+            if (vector == nullptr || vector->size() == 0) continue;  // Not part of the HNSW index either
+            if (vector->size() != queryVector.size()) {
+                throw IllegalArgumentException("Vector dimensions mismatch: query has " +
+                                               std::to_string(queryVector.size()) + ", object " +
+                                               std::to_string(ids[i]) + " has " + std::to_string(vector->size()));
+            }
+            float distance =
+                obx_vector_distance_float32(distanceType_, queryVector.data(), vector->data(), vector->size());
+            results.emplace_back(ids[i], distance);
+        }
+        sortAndTruncate(results, maxResultCount);
+        return results;
+    }
+
+    /// Runs HNSW searches with an increasing max result count until enough results were accepted by the filter.
+    template <typename Builder, typename Accept>
+    std::vector<std::pair<obx_id, double>> searchIndex(const std::vector<float>& queryVector, size_t maxResultCount,
+                                                       uint64_t matchCount, Builder builder, Accept accept) {
+        uint64_t totalCount = box_.count();
+        double selectivity = totalCount > 0 ? static_cast<double>(matchCount) / totalCount : 1.0;
+        double initialCount = std::ceil(maxResultCount * overfetchFactor_ / std::max(selectivity, 1e-9));
+        size_t fetchCount = static_cast<size_t>(std::min(initialCount, static_cast<double>(totalCount)));
+        fetchCount = std::max(fetchCount, maxResultCount);
+
+        std::vector<std::pair<obx_id, double>> results;
+        while (true) {
+            QueryBuilder<EntityT> qb = builder();
+            qb.nearestNeighborsFloat32(vectorProperty_, queryVector, fetchCount);
+            results = qb.build().findIdsWithScores();
+            auto rejected = [&](const std::pair<obx_id, double>& result) { return !accept(result.first); };
+            results.erase(std::remove_if(results.begin(), results.end(), rejected), results.end());
+            bool enough = results.size() >= maxResultCount || results.size() >= matchCount;
+            if (enough || fetchCount >= totalCount) break;
+            fetchCount = static_cast<size_t>(std::min<uint64_t>(totalCount, fetchCount * 2));
+        }
+        sortAndTruncate(results, maxResultCount);
+        return results;
+    }
+
+    std::vector<std::pair<EntityT, double>> readObjects(const std::vector<std::pair<obx_id, double>>& idsWithScores) {
+        std::vector<obx_id> ids;
+        ids.reserve(idsWithScores.size());
+        for (const std::pair<obx_id, double>& idWithScore : idsWithScores) ids.push_back(idWithScore.first);
+        std::vector<std::unique_ptr<EntityT>> objects = box_.get(ids);
+
+        std::vector<std::pair<EntityT, double>> result;
+        result.reserve(objects.size());
+        for (size_t i = 0; i < objects.size(); i++) {
+            if (objects[i]) result.emplace_back(std::move(*objects[i]), idsWithScores[i].second);
+        }
+        return result;
+    }
+};
+
+#endif  // OBX_DISABLE_FLATBUFFERS
+
+/// \brief Intersects the IDs found by multiple queries, e.g. one per indexed property, before reading any object.
+///
+/// A query combining conditions on multiple indexed properties (e.g. tenant, status and date) uses at most one index
+/// and checks the other conditions on each object it reads. If none of the conditions is selective on its own, this
+/// reads a lot of objects. Instead, this class executes each query (typically a single indexed condition) for IDs only
+/// and intersects the sorted IDs. Only objects matching all queries are read (find()).
+/// Queries run in ascending order of their average result count in previous executions of this intersection (queries
+/// without executions first, in the order they were added); once the intersection is empty, no further query runs.
+/// All queries (and reading the objects) use a single read transaction, so the results are consistent.
+template <typename EntityT>
+class QueryIntersection {
+    Store& store_;
+    std::vector<Query<EntityT>> queries_;
+    std::vector<QueryStats> stats_;  ///< Per query; only executions and resultCount are used
+    std::string plan_;
+
+public:
+    explicit QueryIntersection(Store& store) : store_(store) {}
+
+    /// Adds a query; all queries must match for an object to be part of the result.
+    QueryIntersection& add(Query<EntityT>&& query) {
+        queries_.push_back(std::move(query));
+        stats_.push_back(QueryStats());
+        return *this;
+    }
+
+    /// Adds a query built from the given condition, e.g. a condition on a single indexed property.
+    QueryIntersection& add(const QueryCondition& condition) {
+        return add(Box<EntityT>(store_).query(condition).build());
+    }
+
+    /// Access to an added query (in the order of adding), e.g. to set parameters before the next execution.
+    Query<EntityT>& query(size_t index) { return queries_.at(index); }
+
+    /// @returns the IDs of the objects matching all queries in ascending order
+    std::vector<obx_id> findIds() {
+        Transaction tx = store_.txRead();
+        return intersect();
+    }
+
+    /// @returns the objects matching all queries in ascending ID order
+    std::vector<std::unique_ptr<EntityT>> find() {
+        Transaction tx = store_.txRead();
+        return Box<EntityT>(store_).get(intersect());  // IDs are sorted, so objects are read sequentially
+    }
+
+    /// @returns the number of objects matching all queries
+    uint64_t count() { return findIds().size(); }
+
+    /// Describes the last execution: the order in which the queries ran and the number of IDs after each step.
+    const std::string& describe() const { return plan_; }
+
+private:
+    std::vector<obx_id> intersect() {
+        if (queries_.empty()) throw IllegalStateException("No queries were added");
+
+        // Expected result count per query: queries never executed before first (unknown cost) in the order of adding
+        std::vector<double> expected(queries_.size());
+        std::vector<size_t> order(queries_.size());
+        for (size_t i = 0; i < queries_.size(); i++) {
+            const QueryStats& stats = stats_[i];
+            expected[i] = stats.executions ? static_cast<double>(stats.resultCount) / stats.executions : -1.0;
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&expected](size_t a, size_t b) {
+            return expected[a] < expected[b];
+        });
+
+        std::vector<obx_id> result;
+        plan_ = "Intersection of " + std::to_string(queries_.size()) + " queries:";
+        for (size_t step = 0; step < order.size(); step++) {
+            Query<EntityT>& query = queries_[order[step]];
+            plan_ += "\n  " + std::to_string(step + 1) + ". " + query.describeParameters();
+            if (step > 0 && result.empty()) {
+                plan_ += " -> skipped (empty intersection)";
+                continue;
+            }
+            std::vector<obx_id> ids = query.findIds();
+            stats_[order[step]].executions++;
+            stats_[order[step]].resultCount += ids.size();
+            plan_ += " -> " + std::to_string(ids.size()) + " IDs";
+            if (step == 0) {
+                if (!std::is_sorted(ids.begin(), ids.end())) std::sort(ids.begin(), ids.end());
+                result.swap(ids);
+            } else {
+                internal::intersectIds(result, ids);
+                plan_ += ", " + std::to_string(result.size()) + " remaining";
+            }
+        }
+        return result;
+    }
+};
+
+/// Data changes delivered to a DataChangeListener; may cover multiple commits if notifications were coalesced.
+struct DataChanges {
+    /// Sequence number of the first commit covered by these changes; counted by the DataObserver starting at 1.
+    uint64_t firstCommit = 0;
+
+    /// Sequence number of the last commit covered by these changes; equals firstCommit unless coalesced.
+    uint64_t lastCommit = 0;
+
+    /// IDs of the entity types that had changes (ascending order, no duplicates).
+    std::vector<obx_schema_id> typeIds;
+};
+
+/// Receives data changes from a DataObserver.
+class DataChangeListener {
+public:
+    virtual ~DataChangeListener() = default;
+
+    /// Called on the observer's thread (not the committing thread) after data was committed.
+    /// Unlike observer callbacks of the C API, data operations (transactions) are allowed here.
+    virtual void changed(const DataChanges& changes) noexcept = 0;
+};
+
+/// \brief Observes committed data changes and delivers them on a background thread.
+///
+/// Unlike the plain C API (obx_observe()), the committing thread is not blocked by the listener: notifications are put
+/// in a queue, which is processed by a dedicated thread. The queue is bounded to maxQueuedChanges: once the limit is
+/// reached, new notifications are coalesced into the latest queued entry instead of growing the queue. Thus, a slow
+/// listener receives fewer but larger changes; commits are never blocked or dropped.
+/// Remaining changes are still delivered when the observer is closed.
+class DataObserver {
+    std::shared_ptr<DataChangeListener> listener_;
+    const size_t maxQueuedChanges_;
+    const obx_schema_id singleTypeId_;  ///< Non-zero if only a single type is observed
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<DataChanges> queue_;
+    uint64_t commitCount_ = 0;
+    bool stopping_ = false;
+
+    std::thread thread_;
+    OBX_observer* cObserver_ = nullptr;
+
+public:
+    /// Observes changes of all entity types.
+    /// @param maxQueuedChanges number of queued changes after which further changes are coalesced (non-zero).
+    DataObserver(Store& store, std::shared_ptr<DataChangeListener> listener, size_t maxQueuedChanges = 64)
+        : DataObserver(store, 0, std::move(listener), maxQueuedChanges) {}
+
+    /// Observes changes of a single entity type.
+    /// @param maxQueuedChanges number of queued changes after which further changes are coalesced (non-zero).
+    DataObserver(Store& store, obx_schema_id typeId, std::shared_ptr<DataChangeListener> listener,
+                 size_t maxQueuedChanges = 64);
+
+    /// Can't be copied or moved as the C observer and the thread refer to this instance
+    DataObserver(const DataObserver&) = delete;
+
+    ~DataObserver() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    /// Stops observing; remaining changes are delivered before this method returns.
+    /// Must not be called from the listener itself (observer thread).
+    /// Calling close() more than once has no effect.
+    void close();
+
+private:
+    void onCommit(const obx_schema_id* typeIds, size_t typeIdsCount);
+
+    void run();
+};
+
+#ifdef OBX_CPP_FILE
+
+DataObserver::DataObserver(Store& store, obx_schema_id typeId, std::shared_ptr<DataChangeListener> listener,
+                           size_t maxQueuedChanges)
+    : listener_(std::move(listener)), maxQueuedChanges_(maxQueuedChanges), singleTypeId_(typeId) {
+    OBX_VERIFY_ARGUMENT(listener_);
+    OBX_VERIFY_ARGUMENT(maxQueuedChanges_ > 0);
+    OBX_store* cStore = store.cPtr();  // May throw, thus before starting the thread
+    thread_ = std::thread(&DataObserver::run, this);
+
+    if (singleTypeId_) {
+        cObserver_ = obx_observe_single_type(
+            cStore, singleTypeId_,
+            [](void* userData) {
+                DataObserver* self = static_cast<DataObserver*>(userData);
+                self->onCommit(&self->singleTypeId_, 1);
+            },
+            this);
+    } else {
+        cObserver_ = obx_observe(
+            cStore,
+            [](const obx_schema_id* typeIds, size_t typeIdsCount, void* userData) {
+                static_cast<DataObserver*>(userData)->onCommit(typeIds, typeIdsCount);
+            },
+            this);
+    }
+
+    if (!cObserver_) {
+        obx_err err = obx_last_error_code();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        condition_.notify_one();
+        thread_.join();
+        internal::throwLastError(err, "Could not create observer");
+    }
+}
+
+void DataObserver::close() {
+    if (cObserver_) {
+        OBX_VERIFY_STATE(std::this_thread::get_id() != thread_.get_id());
+        internal::checkErrOrThrow(obx_observer_close(cObserver_));
+        cObserver_ = nullptr;
+    }
+    if (thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        condition_.notify_one();
+        thread_.join();
+    }
+}
+
+void DataObserver::onCommit(const obx_schema_id* typeIds, size_t typeIdsCount) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t commit = ++commitCount_;
+        if (queue_.size() >= maxQueuedChanges_) {  // Coalesce into the latest entry to keep the queue bounded
+            DataChanges& latest = queue_.back();
+            latest.lastCommit = commit;
+            latest.typeIds.insert(latest.typeIds.end(), typeIds, typeIds + typeIdsCount);
+            std::sort(latest.typeIds.begin(), latest.typeIds.end());
+            latest.typeIds.erase(std::unique(latest.typeIds.begin(), latest.typeIds.end()), latest.typeIds.end());
+        } else {
+            queue_.emplace_back();
+            DataChanges& changes = queue_.back();
+            changes.firstCommit = commit;
+            changes.lastCommit = commit;
+            changes.typeIds.assign(typeIds, typeIds + typeIdsCount);
+            std::sort(changes.typeIds.begin(), changes.typeIds.end());
+        }
+    }
+    condition_.notify_one();
+}
+
+void DataObserver::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) return;  // Stopping and all changes were delivered
+
+        DataChanges changes = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        listener_->changed(changes);
+        lock.lock();
+    }
+}
+
+#endif  // OBX_CPP_FILE
+
+/// @brief Structural/behavioral options for a tree passed during tree creation.
+class TreeOptions {
+    friend class Tree;
+
+    OBX_tree_options* cOptions_;
+    char pathDelimiter_ = '/';
+
+public:
+    TreeOptions() : cOptions_(obx_tree_options()) {
+        internal::checkPtrOrThrow(cOptions_, "Could not create tree options");
+    }
+
+    /// Move constructor "stealing" the C resource from the source
+    TreeOptions(TreeOptions&& source) noexcept : cOptions_(source.cOptions_) { source.cOptions_ = nullptr; }
+
+    ~TreeOptions() { obx_tree_options_free(cOptions_); }
+
+    /// Can't be copied, single owner of C resources is required (to avoid double-free during destruction)
+    TreeOptions(const TreeOptions&) = delete;
+
+    /// Adjusts the path delimiter character, which is by default "/".
+    TreeOptions& pathDelimiter(char delimiter) {
+        obx_err err = obx_tree_opt_path_delimiter(cOptions_, delimiter);
+        internal::checkErrOrThrow(err);
+        pathDelimiter_ = delimiter;
+        return *this;
+    }
+
+    /// Sets the given OBXTreeOptionFlags. Combine multiple flags using bitwise OR.
+    TreeOptions& flags(uint32_t flags) {
+        obx_err err = obx_tree_opt_flags(cOptions_, flags);
+        internal::checkErrOrThrow(err);
+        return *this;
+    }
+};
+
+/// Regular results in the sense of "not throwing an exception" for put operations via TreeCursor.
+enum class TreePutResult {
+    Undefined,     ///< Not an actual result, will never be returned from a synchronous put operation;
+                   ///< when used in AsyncTreePutResult, however, this indicates an exceptional result.
+    Success,       ///< OK
+    PathNotFound,  ///< Given path did not exist (no meta leaf object given to create it)
+    DidNotPut      ///< According to the given put mode, no put was performed, e.g. "insert but already existed"
+};
+
+namespace internal {
+TreePutResult mapErrorToTreePutResult(obx_err err);
+}  // namespace internal
+
+/// Parameter to AsyncTreePutCallback, which is passed to Tree::putAsync().
+struct AsyncTreePutResult {
+    TreePutResult result;      ///< Non-exceptional results or "Undefined"; in the latter case obx_err has more details
+    obx_err status;            ///< More detailed error code if operation did not succeed
+    obx_id id;                 ///< ID of the leaf that was put if operation succeeded
+    std::string errorMessage;  ///< Non-empty if an error occurred (result is "Undefined")
+
+    ///@returns true if the operation was successful.
+    inline bool isSuccess() { return status == OBX_SUCCESS; }
+
+    /// Alternative to checking error codes: throw an exception instead.
+    /// Note that this will always throw, so you should at least check for a successful outcome, e.g. via isSuccess().
+    [[noreturn]] void throwException() { internal::throwError(status, "Async tree put failed: " + errorMessage); }
+};
+
+struct AsyncTreeGetResult {
     std::string path;  ///< Path of leaf
     obx_err status;    ///< OBX_SUCCESS or OBX_NOT_FOUND if operation did not succeed
 
@@ -3330,6 +6833,9 @@ public:
     /// Can't be copied, single owner of C resources is required (to avoid double-free during destruction)
     Tree(const Tree&) = delete;
 
+    /// The delimiter separating the segments of a path (see TreeOptions::pathDelimiter()).
+    char pathDelimiter() const { return pathDelimiter_; }
+
     /// Returns the leaf name of the given path (the string component after the last path delimiter).
     std::string getLeafName(const std::string& path) const;
 
@@ -3501,6 +7007,29 @@ public:
     obx_id leafId(size_t index) { return obx_tree_leaves_info_id(cLeavesInfo_, index); }
 };
 
+/// A leaf returned by TreeCursor::getMany(); the data is only valid during the lifetime of the transaction and before
+/// the first write to the DB.
+struct TreeLeafRaw {
+    const void* data = nullptr;      ///< FlatBuffers bytes of the data leaf; null if the path was not found
+    size_t size = 0;                 ///< Size of the data leaf
+    const void* metadata = nullptr;  ///< FlatBuffers bytes of the meta leaf (if requested)
+    size_t metadataSize = 0;         ///< Size of the meta leaf
+
+    /// @returns true if a leaf was found at the requested path
+    bool found() const { return data != nullptr; }
+};
+
+/// A leaf passed to the visitor of TreeCursor::exportSubtree(); the pointers are only valid during the visitor call.
+struct TreeLeafExport {
+    const char* path;      ///< Full path of the leaf
+    OBXPropertyType type;  ///< Value type of the leaf
+    obx_id id;             ///< ID of the data leaf
+    const void* data;      ///< FlatBuffers bytes of the data leaf
+    size_t size;           ///< Size of the data leaf
+    const void* metadata;  ///< FlatBuffers bytes of the meta leaf; null if not exported
+    size_t metadataSize;   ///< Size of the meta leaf
+};
+
 /// \brief Primary tree interface against the database.
 /// Offers tree path based get/put functionality.
 /// Not-thread safe: use a TreeCursor instance from one thread only; i.e. the underlying transaction is bound to a
@@ -3551,6 +7080,38 @@ public:
         return true;
     }
 
+    /// Gets the leaves at the given paths (see get()), e.g. to read many leaves sharing deep path prefixes.
+    /// The paths are looked up in sorted order: paths sharing a prefix are resolved consecutively, so the branches of
+    /// the common prefix are hot (CPU caches and DB pages) for all of them. Duplicate paths are only looked up once.
+    /// @param withMetadata whether to also get the meta leaves
+    /// @returns the leaves index-matching the given paths; see TreeLeafRaw::found() for paths that were not found
+    std::vector<TreeLeafRaw> getMany(const std::vector<std::string>& paths, bool withMetadata = false);
+
+    /// Visits all leaves under the given path (recursively, i.e. including leaves of sub-branches) with their path,
+    /// type, ID and data; ordered by path depth (see getLeavesInfo()). Branches are implied by the leaf paths.
+    /// @param path the branch to export; null for the entire tree
+    /// @param visitor returns true to continue or false to stop
+    /// @param withMetadata whether to pass the meta leaves too (importSubtree() needs them to create missing branches)
+    /// @returns the number of visited leaves
+    size_t exportSubtree(const char* path, const std::function<bool(const TreeLeafExport& leaf)>& visitor,
+                         bool withMetadata = true);
+
+    /// Exports all leaves under the given path (see the visitor variant) into a single contiguous buffer, which can be
+    /// stored or sent elsewhere (e.g. for replication) and imported via importSubtree().
+    /// The buffer uses the native byte order; leaf data is 8-byte aligned within the buffer.
+    /// @param outBuffer receives the exported leaves; any previous content is replaced
+    /// @returns the number of exported leaves
+    size_t exportSubtree(const char* path, std::vector<uint8_t>& outBuffer, bool withMetadata = true);
+
+    /// Puts all leaves of a buffer created by exportSubtree() at their paths in the cursor's (write) transaction.
+    /// Missing branches are created if the buffer contains meta leaves; otherwise, the branches must exist already.
+    /// The exported leaves carry the IDs of the source store: each leaf is copied to set its IDs to zero (as required
+    /// by put()), so the target store assigns its own IDs and the buffer is not modified.
+    /// @param dataPutMode for the data leaves; e.g. OBXPutMode_INSERT to keep leaves that exist already
+    /// @returns the number of leaves that were put (leaves not put according to the put mode are not counted)
+    /// @throws IllegalArgumentException if the buffer is not a valid export
+    size_t importSubtree(const std::vector<uint8_t>& buffer, OBXPutMode dataPutMode = OBXPutMode_PUT);
+
     /// Gets the full path (from the root) of the given leaf ID (allocated C string version).
     /// @returns If successful, an allocated path is returned (malloc), which must be free()-ed by the caller.
     /// @returns If not successful, NULL is returned.
@@ -3617,6 +7178,609 @@ public:
     }
 };
 
+#ifdef OBX_CPP_FILE
+std::vector<TreeLeafRaw> TreeCursor::getMany(const std::vector<std::string>& paths, bool withMetadata) {
+    std::vector<TreeLeafRaw> result(paths.size());
+    std::vector<size_t> order(paths.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&paths](size_t a, size_t b) { return paths[a] < paths[b]; });
+
+    for (size_t i = 0; i < order.size(); i++) {
+        TreeLeafRaw& leaf = result[order[i]];
+        if (i > 0 && paths[order[i]] == paths[order[i - 1]]) {  // Sorted, so duplicates are adjacent
+            leaf = result[order[i - 1]];
+            continue;
+        }
+        if (!get(paths[order[i]].c_str(), &leaf.data, &leaf.size, withMetadata ? &leaf.metadata : nullptr,
+                 withMetadata ? &leaf.metadataSize : nullptr)) {
+            leaf = TreeLeafRaw();
+        }
+    }
+    return result;
+}
+
+namespace {
+const char treeExportMagic[8] = {'O', 'B', 'X', 'T', 'R', 'E', 'E', 'X'};
+const uint32_t treeExportFormatVersion = 2;  // Version 2: 64-bit data sizes
+
+/// Fixed-size part of each leaf in an export buffer; followed by the path and the (8-byte aligned) data and metadata.
+struct TreeExportLeafHeader {
+    obx_id id;
+    uint32_t type;
+    uint32_t pathSize;
+    uint64_t dataSize;
+    uint64_t metadataSize;
+};
+
+// The leaf schema of the core is not part of the C API, which only requires the ID slots of leaves passed to
+// obx_tree_cursor_put_raw() to be zero. The layout below is validated on import (see importSubtree()), so a different
+// schema fails the import instead of corrupting leaves.
+
+/// FlatBuffers field indexes (property ID - 1) of the IDs in data leaves: the leaf, its branch and its meta leaf.
+const uint16_t treeDataLeafIdFields[] = {0, 1, 2};
+
+/// FlatBuffers field indexes of the IDs in meta leaves: the meta leaf and its meta branch.
+const uint16_t treeMetaLeafIdFields[] = {0, 2};
+
+size_t alignTo8(size_t offset) { return (offset + 7) & ~static_cast<size_t>(7); }
+
+/// Reads an unsigned FlatBuffers scalar (little endian) of the given size.
+uint64_t readFlatScalar(const uint8_t* bytes, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = size; i-- > 0;) value = (value << 8) | bytes[i];
+    return value;
+}
+
+/// Locates a 64-bit scalar field of the root table in the given FlatBuffers bytes.
+/// @returns the field's offset within the bytes or 0 if the bytes are malformed or the field is not present
+size_t flatRootField64(const uint8_t* bytes, size_t size, uint16_t fieldIndex) {
+    if (size < 4) return 0;
+    uint64_t table = readFlatScalar(bytes, 4);
+    if (table > size - 4) return 0;
+    int64_t vtable = static_cast<int64_t>(table) - static_cast<int32_t>(readFlatScalar(bytes + table, 4));
+    if (vtable < 0 || static_cast<uint64_t>(vtable) > size - 4) return 0;
+    size_t vtableSize = static_cast<size_t>(readFlatScalar(bytes + vtable, 2));
+    size_t fieldEntry = 4 + 2 * static_cast<size_t>(fieldIndex);
+    if (fieldEntry + 2 > vtableSize || static_cast<uint64_t>(vtable) + fieldEntry + 2 > size) return 0;
+    size_t fieldOffset = static_cast<size_t>(readFlatScalar(bytes + vtable + fieldEntry, 2));
+    if (fieldOffset == 0 || fieldOffset + 8 > size - table) return 0;
+    return static_cast<size_t>(table) + fieldOffset;
+}
+
+/// Sets the given ID fields of a leaf's FlatBuffers to zero, as put() requires; the core assigns the target's IDs.
+/// @param outIds receives the previous (source) IDs of the fields, e.g. to check the leaf layout against
+void zeroTreeLeafIds(uint8_t* bytes, size_t size, const uint16_t* fields, size_t fieldCount, obx_id* outIds) {
+    for (size_t i = 0; i < fieldCount; i++) {
+        size_t offset = flatRootField64(bytes, size, fields[i]);
+        if (offset == 0) throw IllegalArgumentException("Subtree export contains a leaf without ID slots");
+        outIds[i] = readFlatScalar(bytes + offset, 8);
+        memset(bytes + offset, 0, 8);
+    }
+}
+
+void appendAligned(std::vector<uint8_t>& buffer, const void* data, size_t size) {
+    buffer.resize(alignTo8(buffer.size()));
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+}  // namespace
+
+size_t TreeCursor::exportSubtree(const char* path, const std::function<bool(const TreeLeafExport& leaf)>& visitor,
+                                 bool withMetadata) {
+    LeavesInfo leaves = getLeavesInfo(path);
+    size_t count = leaves.size();
+    for (size_t i = 0; i < count; i++) {
+        const char* leafPath = leaves.leafPathCString(i);
+        TreeLeafExport leaf{leafPath, leaves.leafPropertyType(i), leaves.leafId(i), nullptr, 0, nullptr, 0};
+        if (!get(leafPath, &leaf.data, &leaf.size, withMetadata ? &leaf.metadata : nullptr,
+                 withMetadata ? &leaf.metadataSize : nullptr)) {
+            throw IllegalStateException(std::string("Leaf vanished during export: ") + leafPath);
+        }
+        if (!visitor(leaf)) return i + 1;
+    }
+    return count;
+}
+
+size_t TreeCursor::exportSubtree(const char* path, std::vector<uint8_t>& outBuffer, bool withMetadata) {
+    outBuffer.assign(treeExportMagic, treeExportMagic + sizeof(treeExportMagic));
+    appendAligned(outBuffer, &treeExportFormatVersion, sizeof(treeExportFormatVersion));
+    return exportSubtree(
+        path,
+        [&outBuffer](const TreeLeafExport& leaf) {
+            size_t pathSize = strlen(leaf.path);
+            if (pathSize > UINT32_MAX) throw IllegalArgumentException("Leaf path is too long to export");
+            TreeExportLeafHeader header{leaf.id, static_cast<uint32_t>(leaf.type), static_cast<uint32_t>(pathSize),
+                                        leaf.size, leaf.metadataSize};
+            appendAligned(outBuffer, &header, sizeof(header));
+            outBuffer.insert(outBuffer.end(), leaf.path, leaf.path + pathSize);
+            appendAligned(outBuffer, leaf.data, leaf.size);
+            if (leaf.metadataSize) appendAligned(outBuffer, leaf.metadata, leaf.metadataSize);
+            return true;
+        },
+        withMetadata);
+}
+
+size_t TreeCursor::importSubtree(const std::vector<uint8_t>& buffer, OBXPutMode dataPutMode) {
+    const size_t headerEnd = alignTo8(sizeof(treeExportMagic)) + sizeof(treeExportFormatVersion);
+    uint32_t version = 0;
+    if (buffer.size() >= headerEnd) memcpy(&version, buffer.data() + alignTo8(sizeof(treeExportMagic)), 4);
+    if (buffer.size() < headerEnd || memcmp(buffer.data(), treeExportMagic, sizeof(treeExportMagic)) != 0 ||
+        version != treeExportFormatVersion) {
+        throw IllegalArgumentException("Not a valid subtree export (unknown header or version)");
+    }
+
+    size_t count = 0;
+    size_t offset = headerEnd;
+    std::string path;
+    std::vector<uint64_t> leafBytes;  // Copy of the current leaf's data and metadata; uint64_t keeps it 8-byte aligned
+    while (alignTo8(offset) < buffer.size()) {
+        offset = alignTo8(offset);
+        TreeExportLeafHeader header;
+        if (buffer.size() - offset < sizeof(header)) throw IllegalArgumentException("Subtree export is truncated");
+        memcpy(&header, buffer.data() + offset, sizeof(header));
+        offset += sizeof(header);
+        // Checks each size against the remaining bytes, so corrupt sizes can not overflow the offsets
+        if (header.pathSize > buffer.size() - offset) throw IllegalArgumentException("Subtree export is truncated");
+        size_t dataOffset = alignTo8(offset + header.pathSize);
+        if (dataOffset > buffer.size() || header.dataSize > buffer.size() - dataOffset) {
+            throw IllegalArgumentException("Subtree export is truncated");
+        }
+        size_t dataSize = static_cast<size_t>(header.dataSize);
+        size_t metadataSize = static_cast<size_t>(header.metadataSize);
+        size_t end = dataOffset + dataSize;
+        size_t metadataOffset = metadataSize ? alignTo8(end) : end;
+        if (metadataSize) {
+            if (metadataOffset > buffer.size() || header.metadataSize > buffer.size() - metadataOffset) {
+                throw IllegalArgumentException("Subtree export is truncated");
+            }
+            end = metadataOffset + metadataSize;
+        }
+
+        path.assign(reinterpret_cast<const char*>(buffer.data() + offset), header.pathSize);
+        size_t metadataCopyOffset = alignTo8(dataSize);
+        leafBytes.resize((metadataCopyOffset + metadataSize + 7) / 8);
+        uint8_t* data = reinterpret_cast<uint8_t*>(leafBytes.data());
+        uint8_t* metadata = metadataSize ? data + metadataCopyOffset : nullptr;
+        memcpy(data, buffer.data() + dataOffset, dataSize);
+        if (metadata) memcpy(metadata, buffer.data() + metadataOffset, metadataSize);
+        // Validates the assumed layout: the leaf's own ID and its reference to the meta leaf must match the export
+        obx_id dataIds[3];
+        zeroTreeLeafIds(data, dataSize, treeDataLeafIdFields, 3, dataIds);
+        if (dataIds[0] != header.id || dataIds[1] == 0 || dataIds[2] == 0) {
+            throw IllegalArgumentException("Subtree export contains a data leaf with an unexpected ID layout: " + path);
+        }
+        if (metadata) {
+            obx_id metaIds[2];
+            zeroTreeLeafIds(metadata, metadataSize, treeMetaLeafIdFields, 2, metaIds);
+            if (metaIds[0] != dataIds[2] || metaIds[1] == 0) {
+                throw IllegalArgumentException("Subtree export contains a meta leaf with an unexpected ID layout: " +
+                                               path);
+            }
+        }
+        TreePutResult result = put(path.c_str(), data, dataSize, static_cast<OBXPropertyType>(header.type), nullptr,
+                                   metadata, metadataSize, dataPutMode);
+        if (result == TreePutResult::PathNotFound) {
+            throw IllegalStateException("Can not import leaf without meta leaf; branch does not exist: " + path);
+        }
+        if (result == TreePutResult::Success) count++;
+        offset = end;
+    }
+    return count;
+}
+#endif
+
+/// A leaf to put via AsyncTreeBatcher::putBatch(); owns its bytes as the put is executed later.
+struct TreeBatchPut {
+    std::string path;               ///< Path of the leaf
+    std::vector<uint8_t> data;      ///< FlatBuffers bytes of the data leaf; see TreeCursor::put()
+    OBXPropertyType type;           ///< Value type of the leaf
+    std::vector<uint8_t> metadata;  ///< Optional FlatBuffers bytes of the meta leaf to create missing branches
+};
+
+/// Called once per batch with results index-matching the batch items.
+using AsyncTreeBatchPutCallback = std::function<void(const std::vector<AsyncTreePutResult>& results)>;
+
+/// Called once per batch with results index-matching the paths; the leaf data is only valid during the call.
+/// Note: the results do not contain leaf IDs (0); use TreeCursor::getLeavesInfo() if needed.
+using AsyncTreeBatchGetCallback = std::function<void(const std::vector<AsyncTreeGetResult>& results)>;
+
+/// \brief Executes batches of tree puts or gets asynchronously; each batch in a single transaction.
+///
+/// Unlike Tree::putAsync() and Tree::getAsync(), which enqueue and notify per leaf, a batch of leaves is enqueued at
+/// once and a single callback receives the results of all its leaves. Batches are executed in order on a background
+/// thread owned by this object; put batches use one write transaction each, get batches one read transaction.
+/// Callbacks are called on the background thread (after the commit for puts) and should return quickly.
+class AsyncTreeBatcher {
+    Store& store_;
+    Tree& tree_;
+    size_t maxQueuedBatches_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<std::function<void()>> queue_;
+    size_t running_ = 0;
+    bool stopping_ = false;
+    std::thread thread_;
+
+public:
+    /// @param maxQueuedBatches enqueueing blocks while this many batches are waiting (back pressure)
+    AsyncTreeBatcher(Store& store, Tree& tree, size_t maxQueuedBatches = 1000);
+
+    /// Executes the remaining batches before returning.
+    virtual ~AsyncTreeBatcher();
+
+    /// Can't be copied or moved: the background thread refers to it
+    AsyncTreeBatcher(const AsyncTreeBatcher&) = delete;
+
+    /// Enqueues the given puts, which are executed in a single write transaction.
+    /// If a put fails, the others are still put; if the commit fails, all results carry the commit error.
+    /// @param callback optional; receives a result per put
+    void putBatch(std::vector<TreeBatchPut> puts, AsyncTreeBatchPutCallback callback = {},
+                  OBXPutMode dataPutMode = OBXPutMode_PUT);
+
+    /// Enqueues gets of the given paths, which are executed in a single read transaction.
+    /// @param callback receives a result per path (status OBX_NOT_FOUND for paths that were not found)
+    void getBatch(std::vector<std::string> paths, bool withMetadata, AsyncTreeBatchGetCallback callback);
+
+    /// Waits until all batches enqueued so far were executed (including their callbacks).
+    void awaitCompletion();
+
+private:
+    void enqueue(std::function<void()> batch);
+
+    void run();
+
+    void executePuts(std::vector<TreeBatchPut>& puts, const AsyncTreeBatchPutCallback& callback, OBXPutMode mode);
+
+    void executeGets(const std::vector<std::string>& paths, bool withMetadata,
+                     const AsyncTreeBatchGetCallback& callback);
+};
+
+#ifdef OBX_CPP_FILE
+AsyncTreeBatcher::AsyncTreeBatcher(Store& store, Tree& tree, size_t maxQueuedBatches)
+    : store_(store), tree_(tree), maxQueuedBatches_(std::max(maxQueuedBatches, size_t(1))) {
+    thread_ = std::thread(&AsyncTreeBatcher::run, this);  // Last: may throw, e.g. if no more threads are available
+}
+
+AsyncTreeBatcher::~AsyncTreeBatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void AsyncTreeBatcher::putBatch(std::vector<TreeBatchPut> puts, AsyncTreeBatchPutCallback callback,
+                                OBXPutMode dataPutMode) {
+    // C++11 lambdas can't move-capture: share the batch with the queued function instead
+    auto batch = std::make_shared<std::vector<TreeBatchPut>>(std::move(puts));
+    auto sharedCallback = std::make_shared<AsyncTreeBatchPutCallback>(std::move(callback));
+    enqueue([this, batch, sharedCallback, dataPutMode]() { executePuts(*batch, *sharedCallback, dataPutMode); });
+}
+
+void AsyncTreeBatcher::getBatch(std::vector<std::string> paths, bool withMetadata,
+                                AsyncTreeBatchGetCallback callback) {
+    auto batch = std::make_shared<std::vector<std::string>>(std::move(paths));
+    auto sharedCallback = std::make_shared<AsyncTreeBatchGetCallback>(std::move(callback));
+    enqueue([this, batch, sharedCallback, withMetadata]() { executeGets(*batch, withMetadata, *sharedCallback); });
+}
+
+void AsyncTreeBatcher::awaitCompletion() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return queue_.empty() && running_ == 0; });
+}
+
+void AsyncTreeBatcher::enqueue(std::function<void()> batch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopping_) throw ShuttingDownException("AsyncTreeBatcher is shutting down");
+    condition_.wait(lock, [this] { return queue_.size() < maxQueuedBatches_; });
+    queue_.push_back(std::move(batch));
+    lock.unlock();
+    condition_.notify_all();
+}
+
+void AsyncTreeBatcher::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) return;  // Stopping and all batches are done
+        std::function<void()> batch = std::move(queue_.front());
+        queue_.pop_front();
+        running_++;
+        lock.unlock();
+        condition_.notify_all();  // Space for blocked enqueue() calls
+        try {
+            batch();
+        } catch (...) {  // E.g. thrown by a callback: keep executing the following batches
+        }
+        lock.lock();
+        running_--;
+        condition_.notify_all();  // For awaitCompletion()
+    }
+}
+
+void AsyncTreeBatcher::executePuts(std::vector<TreeBatchPut>& puts, const AsyncTreeBatchPutCallback& callback,
+                                   OBXPutMode mode) {
+    std::vector<AsyncTreePutResult> results(puts.size(), AsyncTreePutResult{TreePutResult::Undefined, 0, 0, ""});
+    try {
+        Transaction tx(store_, TxMode::WRITE);
+        {
+            TreeCursor cursor(tree_, tx);
+            for (size_t i = 0; i < puts.size(); i++) {
+                TreeBatchPut& put = puts[i];
+                AsyncTreePutResult& result = results[i];
+                void* metadata = put.metadata.empty() ? nullptr : put.metadata.data();
+                try {
+                    result.result = cursor.put(put.path.c_str(), put.data.data(), put.data.size(), put.type,
+                                               &result.id, metadata, put.metadata.size(), mode);
+                    result.status = result.result == TreePutResult::Success     ? OBX_SUCCESS
+                                    : result.result == TreePutResult::DidNotPut ? OBX_NO_SUCCESS
+                                                                                : OBX_NOT_FOUND;
+                } catch (const Exception& e) {
+                    result = AsyncTreePutResult{TreePutResult::Undefined, e.code(), 0, e.what()};
+                }
+            }
+        }
+        tx.success();
+    } catch (const Exception& e) {  // Failed to begin or commit: nothing was put
+        for (AsyncTreePutResult& result : results) {
+            result = AsyncTreePutResult{TreePutResult::Undefined, e.code() ? e.code() : OBX_ERROR_GENERAL, 0, e.what()};
+        }
+    }
+    if (callback) callback(results);
+}
+
+void AsyncTreeBatcher::executeGets(const std::vector<std::string>& paths, bool withMetadata,
+                                   const AsyncTreeBatchGetCallback& callback) {
+    std::vector<AsyncTreeGetResult> results;
+    results.reserve(paths.size());
+    std::unique_ptr<Transaction> tx;  // Kept until the callback returns: the leaf data is valid during the call
+    try {
+        tx.reset(new Transaction(store_, TxMode::READ));
+        TreeCursor cursor(tree_, *tx);
+        std::vector<TreeLeafRaw> leaves = cursor.getMany(paths, withMetadata);
+        for (size_t i = 0; i < paths.size(); i++) {
+            const TreeLeafRaw& leaf = leaves[i];
+            obx_err status = leaf.found() ? OBX_SUCCESS : OBX_NOT_FOUND;
+            results.push_back(AsyncTreeGetResult{
+                paths[i], status, 0, {leaf.data, leaf.size}, {leaf.metadata, leaf.metadataSize}, std::string()});
+        }
+    } catch (const Exception& e) {
+        results.clear();
+        for (const std::string& path : paths) {
+            results.push_back(AsyncTreeGetResult{path, e.code() ? e.code() : OBX_ERROR_GENERAL, 0, {nullptr, 0},
+                                                 {nullptr, 0}, e.what()});
+        }
+    }
+    if (callback) callback(results);
+}
+#endif
+
+/// Extracts the value to index from the FlatBuffers bytes of a data leaf (the leaf layout is defined by the tree).
+/// @param outValue receives the value in a comparable binary form, e.g. the string or the bytes of a scalar
+/// @returns false to not index the leaf (e.g. if it has no value)
+using TreeValueExtractor = std::function<bool(const void* data, size_t size, std::string& outValue)>;
+
+/// A leaf found by TreeValueIndex::find().
+struct TreeIndexedLeaf {
+    obx_id id;         ///< ID of the data leaf
+    std::string path;  ///< Full path of the leaf
+};
+
+/// \brief In-memory secondary index on tree leaf values for reverse lookups, e.g. all devices with firmware 1.2.
+///
+/// Tree leaves can only be looked up by path; without an index, finding leaves by value requires visiting the entire
+/// tree. A value index is opt-in for a leaf type and optionally scoped to a path pattern, e.g. "devices/*/firmware",
+/// where "*" matches exactly one path segment. Only leaves matching both are indexed.
+///
+/// The index is populated by rebuild() and only reflects changes that are passed to update() and remove(); call these
+/// after the respective transaction was committed. The index is not notified by any writes to the tree, so it goes
+/// stale with changes done by other means, e.g. AsyncTree::putAsync(), AsyncTreeBatcher, Tree::importSubtree() or
+/// other processes; call update() for the affected paths or rebuild() after such changes.
+/// Lookups are thread-safe and do not access the DB.
+class TreeValueIndex {
+    const OBXPropertyType type_;
+    const char pathDelimiter_;
+    std::vector<std::string> patternSegments_;  ///< Empty to match all paths
+    std::string scanPath_;                      ///< Pattern prefix before the first wildcard; empty for the root
+    TreeValueExtractor extractor_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::map<std::string, obx_id>> leavesByValue_;  ///< Value -> path -> leaf ID
+    std::unordered_map<std::string, std::string> valueByPath_;
+
+public:
+    /// @param tree the tree to index; only used for its path delimiter
+    /// @param type only leaves having this type are indexed
+    /// @param pathPattern only leaves with matching paths are indexed; "*" matches one path segment; empty for all
+    /// @param extractor gets the value from the leaf data
+    TreeValueIndex(const Tree& tree, OBXPropertyType type, const std::string& pathPattern,
+                   TreeValueExtractor extractor);
+
+    /// Can't be copied or moved: lookups may happen concurrently
+    TreeValueIndex(const TreeValueIndex&) = delete;
+
+    /// @returns true if leaves at the given path are covered by the path pattern of this index.
+    bool matchesPath(const std::string& path) const;
+
+    /// Replaces the index content with all matching leaves of the tree.
+    /// Only the branch of the pattern's prefix before the first wildcard is visited; i.e. a pattern like
+    /// "devices/*/firmware" limits the scan to leaves below "devices".
+    /// @returns the number of indexed leaves
+    size_t rebuild(TreeCursor& cursor);
+
+    /// Updates the index for the leaf at the given path, which was put or removed (e.g. after committing).
+    /// Leaves not matching the type or path pattern of this index are ignored.
+    void update(TreeCursor& cursor, const std::string& path);
+
+    /// Updates the index for a leaf that was put with the given data, e.g. right after TreeCursor::put().
+    /// Leaves not matching the type or path pattern of this index are ignored.
+    void update(const std::string& path, obx_id id, OBXPropertyType type, const void* data, size_t size);
+
+    /// Removes the leaf at the given path from the index (if it was indexed).
+    void remove(const std::string& path);
+
+    /// @returns the leaves having the given value, ordered by path
+    std::vector<TreeIndexedLeaf> find(const std::string& value) const;
+
+    /// @returns the IDs of the leaves having the given value, ordered by path
+    std::vector<obx_id> findIds(const std::string& value) const;
+
+    /// @returns the number of leaves having the given value
+    size_t count(const std::string& value) const;
+
+    /// @returns the number of indexed leaves
+    size_t size() const;
+
+private:
+    void putEntry(const std::string& path, obx_id id, std::string&& value);
+
+    void removeEntry(const std::string& path);
+};
+
+#ifdef OBX_CPP_FILE
+TreeValueIndex::TreeValueIndex(const Tree& tree, OBXPropertyType type, const std::string& pathPattern,
+                               TreeValueExtractor extractor)
+    : type_(type), pathDelimiter_(tree.pathDelimiter()), extractor_(std::move(extractor)) {
+    OBX_VERIFY_ARGUMENT(extractor_);
+    if (pathPattern.empty()) return;
+    size_t start = 0;
+    bool wildcardSeen = false;
+    while (true) {
+        size_t end = pathPattern.find(pathDelimiter_, start);
+        std::string segment = pathPattern.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        if (segment.empty()) throw IllegalArgumentException("Path pattern has an empty segment: " + pathPattern);
+        if (segment == "*") wildcardSeen = true;
+        if (!wildcardSeen && end != std::string::npos) {  // The last segment is the leaf, not a branch to scan
+            if (!scanPath_.empty()) scanPath_ += pathDelimiter_;
+            scanPath_ += segment;
+        }
+        patternSegments_.push_back(std::move(segment));
+        if (end == std::string::npos) break;
+        start = end + 1;
+    }
+}
+
+bool TreeValueIndex::matchesPath(const std::string& path) const {
+    if (patternSegments_.empty()) return true;
+    size_t start = 0;
+    for (size_t i = 0; i < patternSegments_.size(); i++) {
+        size_t end = path.find(pathDelimiter_, start);
+        bool last = i + 1 == patternSegments_.size();
+        if ((end == std::string::npos) != last) return false;  // Different number of segments
+        size_t length = (last ? path.size() : end) - start;
+        const std::string& pattern = patternSegments_[i];
+        if (pattern == "*") {
+            if (length == 0) return false;
+        } else if (pattern.size() != length || path.compare(start, length, pattern) != 0) {
+            return false;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+size_t TreeValueIndex::rebuild(TreeCursor& cursor) {
+    std::unordered_map<std::string, std::map<std::string, obx_id>> leavesByValue;
+    std::unordered_map<std::string, std::string> valueByPath;
+    LeavesInfo leaves = cursor.getLeavesInfo(scanPath_.empty() ? nullptr : scanPath_.c_str());
+    size_t leafCount = leaves.size();
+    std::string value;
+    for (size_t i = 0; i < leafCount; i++) {
+        if (leaves.leafPropertyType(i) != type_) continue;
+        std::string path = leaves.leafPath(i);
+        if (!matchesPath(path)) continue;
+        const void* data = nullptr;
+        size_t size = 0;
+        if (!cursor.get(path.c_str(), &data, &size)) continue;
+        value.clear();
+        if (!extractor_(data, size, value)) continue;
+        leavesByValue[value][path] = leaves.leafId(i);
+        valueByPath[std::move(path)] = value;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    leavesByValue_.swap(leavesByValue);
+    valueByPath_.swap(valueByPath);
+    return valueByPath_.size();
+}
+
+void TreeValueIndex::update(TreeCursor& cursor, const std::string& path) {
+    if (!matchesPath(path)) return;
+    const void* data = nullptr;
+    size_t size = 0;
+    if (!cursor.get(path.c_str(), &data, &size)) {
+        remove(path);
+        return;
+    }
+    LeavesInfo leaves = cursor.getLeavesInfo(path);
+    if (leaves.size() != 1) throw IllegalStateException("Could not get the leaf info for path " + path);
+    update(path, leaves.leafId(0), leaves.leafPropertyType(0), data, size);
+}
+
+void TreeValueIndex::update(const std::string& path, obx_id id, OBXPropertyType type, const void* data,
+                            size_t size) {
+    if (!matchesPath(path)) return;
+    std::string value;
+    bool indexed = type == type_ && extractor_(data, size, value);
+    std::lock_guard<std::mutex> lock(mutex_);
+    removeEntry(path);
+    if (indexed) putEntry(path, id, std::move(value));
+}
+
+void TreeValueIndex::remove(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    removeEntry(path);
+}
+
+void TreeValueIndex::putEntry(const std::string& path, obx_id id, std::string&& value) {
+    leavesByValue_[value][path] = id;
+    valueByPath_[path] = std::move(value);
+}
+
+void TreeValueIndex::removeEntry(const std::string& path) {
+    auto byPath = valueByPath_.find(path);
+    if (byPath == valueByPath_.end()) return;
+    auto byValue = leavesByValue_.find(byPath->second);
+    if (byValue != leavesByValue_.end()) {
+        byValue->second.erase(path);
+        if (byValue->second.empty()) leavesByValue_.erase(byValue);
+    }
+    valueByPath_.erase(byPath);
+}
+
+std::vector<TreeIndexedLeaf> TreeValueIndex::find(const std::string& value) const {
+    std::vector<TreeIndexedLeaf> result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto byValue = leavesByValue_.find(value);
+    if (byValue == leavesByValue_.end()) return result;
+    result.reserve(byValue->second.size());
+    for (const auto& leaf : byValue->second) result.push_back(TreeIndexedLeaf{leaf.second, leaf.first});
+    return result;
+}
+
+std::vector<obx_id> TreeValueIndex::findIds(const std::string& value) const {
+    std::vector<obx_id> result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto byValue = leavesByValue_.find(value);
+    if (byValue == leavesByValue_.end()) return result;
+    result.reserve(byValue->second.size());
+    for (const auto& leaf : byValue->second) result.push_back(leaf.second);
+    return result;
+}
+
+size_t TreeValueIndex::count(const std::string& value) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto byValue = leavesByValue_.find(value);
+    return byValue == leavesByValue_.end() ? 0 : byValue->second.size();
+}
+
+size_t TreeValueIndex::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return valueByPath_.size();
+}
+#endif
+
 /**@}*/  // end of doxygen group "cpp ObjectBox C++ API"
 }  // namespace obx
 
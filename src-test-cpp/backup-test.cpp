@@ -0,0 +1,87 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+
+#include "test.hpp"
+
+namespace {
+obx::BackupSink appendTo(std::string& out) {
+    return [&out](const void* data, size_t size) { out.append(static_cast<const char*>(data), size); };
+}
+
+obx::BackupSource readFrom(const std::string& in) {
+    std::shared_ptr<size_t> position = std::make_shared<size_t>(0);
+    return [&in, position](void* buffer, size_t size) {
+        size_t count = std::min(size, in.size() - *position);
+        memcpy(buffer, in.data() + *position, count);
+        *position += count;
+        return count;
+    };
+}
+
+void checkSameItems(obx::Box<Item>& expectedBox, obx::Box<Item>& actualBox) {
+    CHECK(actualBox.count() == expectedBox.count());
+    for (const std::unique_ptr<Item>& expected : expectedBox.getAll()) {
+        std::unique_ptr<Item> actual = actualBox.get(expected->id);
+        CHECK(actual);
+        CHECK(actual->text == expected->text);
+        CHECK(actual->value == expected->value);
+    }
+}
+}  // namespace
+
+void testIncrementalBackup() {
+    obx::Store store(testOptions("testdata-backup"));
+    obx::Box<Item> box(store);
+    std::vector<obx_id> ids;
+    for (int64_t i = 0; i < 100; i++) ids.push_back(box.put(newItem("item " + std::to_string(i), i)));
+
+    obx::IncrementalBackup backup(store, {Item::_OBX_MetaInfo::entityId()});
+    std::string full;
+    obx::BackupManifest manifest = backup.backUp(appendTo(full));
+
+    // The manifest survives saving and loading
+    std::string savedManifest;
+    manifest.save(appendTo(savedManifest));
+    obx::BackupManifest loadedManifest = obx::BackupManifest::load(readFrom(savedManifest));
+    CHECK(loadedManifest.backupId() == manifest.backupId());
+
+    // Update (same size), remove and insert objects
+    std::unique_ptr<Item> changed = box.get(ids[10]);
+    changed->value = -10;
+    box.put(*changed);
+    box.remove(ids[20]);
+    obx_id addedId = box.put(newItem("added", 1000));
+
+    std::string incremental;
+    backup.backUp(appendTo(incremental), &loadedManifest);
+    CHECK(incremental.size() < full.size() / 10);  // Only the changes
+
+    obx::Store restoredStore(testOptions("testdata-backup-restored"));
+    obx::Box<Item> restoredBox(restoredStore);
+    uint64_t backupId = obx::IncrementalBackup::restore(restoredStore, readFrom(full));
+    CHECK(backupId == manifest.backupId());
+    CHECK(restoredBox.count() == ids.size());
+
+    // An incremental backup requires its base to be restored before
+    CHECK_THROWS(obx::IncrementalBackup::restore(restoredStore, readFrom(incremental), 0), obx::DbException);
+    obx::IncrementalBackup::restore(restoredStore, readFrom(incremental), backupId);
+    checkSameItems(box, restoredBox);
+
+    // The ID sequence was advanced beyond the restored IDs
+    CHECK(restoredBox.put(newItem("new", 0)) > addedId);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+void testCompactionSparseIds() {
+    obx::Store source(testOptions("testdata-compaction-source"));
+    obx::Box<Item> sourceBox(source);
+    std::vector<Item> items;
+    for (int64_t i = 0; i < 10000; i++) items.push_back(newItem("item " + std::to_string(i), i));
+    sourceBox.put(items);
+
+    // Keep every 1000th object only, i.e. copied IDs have gaps of 999 IDs
+    std::vector<obx_id> removedIds;
+    for (const Item& item : items) {
+        if (item.value % 1000 != 999) removedIds.push_back(item.id);
+    }
+    sourceBox.remove(removedIds);
+    CHECK(sourceBox.count() == 10);
+
+    obx::Store target(testOptions("testdata-compaction-target"));
+    std::vector<obx::CompactionProgress> progress;
+    obx::CompactionResult result = obx::StoreCompaction(source, target, {Item::_OBX_MetaInfo::entityId()})
+                                       .maxBytesPerTransaction(1)  // A transaction per object
+                                       .onProgress([&](const obx::CompactionProgress& p) { progress.push_back(p); })
+                                       .run();
+    CHECK(result.objects == 10);
+    CHECK(progress.size() == 10);
+
+    obx::Box<Item> targetBox(target);
+    CHECK(targetBox.count() == 10);
+    for (const std::unique_ptr<Item>& expected : sourceBox.getAll()) {
+        std::unique_ptr<Item> actual = targetBox.get(expected->id);
+        CHECK(actual && actual->text == expected->text && actual->value == expected->value);
+    }
+
+    // The target's ID sequence was advanced beyond the copied IDs
+    CHECK(targetBox.put(newItem("new", 0)) > items.back().id);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <set>
+#include <thread>
+
+#include "test.hpp"
+
+namespace {
+const size_t threadCount = 8;
+
+/// Runs fn(threadIndex) on threadCount threads concurrently and waits for all of them.
+template <typename Fn>
+void onThreads(Fn fn) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCount; i++) threads.emplace_back(fn, i);
+    for (std::thread& thread : threads) thread.join();
+}
+
+/// With maxOperations equal to the number of threads (and a long max wait), the leader commits once all joined.
+void testGrouping(obx::Store& store) {
+    obx::GroupCommit groupCommit(store, std::chrono::seconds(10), threadCount);
+    obx::Box<Item> box(store);
+    std::mutex mutex;
+    std::set<std::thread::id> runningThreads;
+    std::vector<obx_id> ids(threadCount);
+
+    onThreads([&](size_t index) {
+        Item item = newItem("item " + std::to_string(index), int64_t(index));
+        groupCommit.run([&]() {
+            ids[index] = box.put(item);
+            std::lock_guard<std::mutex> lock(mutex);
+            runningThreads.insert(std::this_thread::get_id());
+        });
+    });
+
+    CHECK(runningThreads.size() == 1);  // All operations ran in the leader's transaction
+    CHECK(box.count() == threadCount);
+    CHECK(std::set<obx_id>(ids.begin(), ids.end()).size() == threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        std::unique_ptr<Item> item = box.get(ids[i]);
+        CHECK(item && item->value == int64_t(i));
+    }
+}
+
+/// One failing operation makes the shared transaction fail: each operation is retried on its own and only the caller
+/// of the failing one gets the exception.
+void testFailingOperation(obx::Store& store) {
+    obx::GroupCommit groupCommit(store, std::chrono::seconds(10), threadCount);
+    obx::Box<Item> box(store);
+    box.removeAll();
+    const size_t failingIndex = 3;
+    std::vector<std::string> errors(threadCount);
+    std::vector<int> runs(threadCount);
+
+    onThreads([&](size_t index) {
+        try {
+            groupCommit.run([&]() {
+                runs[index]++;
+                box.put(newItem("item " + std::to_string(index), int64_t(index)));
+                if (index == failingIndex) throw std::runtime_error("failing " + std::to_string(index));
+            });
+        } catch (const std::exception& e) {
+            errors[index] = e.what();
+        }
+    });
+
+    for (size_t i = 0; i < threadCount; i++) {
+        CHECK(runs[i] == 2);  // In the shared transaction, and alone
+        CHECK(errors[i] == (i == failingIndex ? "failing " + std::to_string(i) : std::string()));
+    }
+    CHECK(box.count() == threadCount - 1);
+    CHECK(box.query(Item_::value.equals(int64_t(failingIndex))).build().count() == 0);
+}
+
+void testWithinTransaction(obx::Store& store) {
+    obx::GroupCommit groupCommit(store);
+    obx::Transaction tx = store.txRead();
+    CHECK_THROWS(groupCommit.run([]() {}), obx::IllegalStateException);
+}
+}  // namespace
+
+void testGroupCommit() {
+    obx::Store store(testOptions("testdata-group-commit"));
+    testGrouping(store);
+    testFailingOperation(store);
+    testWithinTransaction(store);
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define OBX_CPP_FILE
+#include <cstdio>
+
+#include "test.hpp"
+
+namespace {
+int failures = 0;
+
+void run(const char* name, void test()) {
+    printf("%s...\n", name);
+    try {
+        test();
+    } catch (const std::exception& e) {
+        printf("FAILED %s: %s\n", name, e.what());
+        failures++;
+    }
+}
+}  // namespace
+
+int main() {
+    printf("Testing libobjectbox version %s, core version: %s\n", obx_version_string(), obx_version_core_string());
+
+    run("GroupCommit", testGroupCommit);
+    run("IncrementalBackup", testIncrementalBackup);
+    run("StoreCompaction with sparse IDs", testCompactionSparseIds);
+    run("BackgroundValidation resume", testBackgroundValidationResume);
+    run("ObjectCache", testObjectCache);
+    run("Tree export/import", testTreeExportImport);
+    run("TreeValueIndex", testTreeValueIndex);
+
+    if (failures) {
+        printf("%d test(s) failed\n", failures);
+        return 1;
+    }
+    printf("All tests passed\n");
+    return 0;
+}
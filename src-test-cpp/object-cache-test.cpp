@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "test.hpp"
+
+namespace {
+/// Puts the item via the C API, i.e. bypassing the invalidation done by Box; the cache only learns about it once the
+/// core notifies its observer.
+void putExternally(obx::Box<Item>& box, const Item& item) {
+    flatbuffers::FlatBufferBuilder fbb;
+    Item::_OBX_MetaInfo::toFlatBuffer(fbb, item);
+    obx_id id = obx_box_put_object4(box.cPtr(), fbb.GetBufferPointer(), fbb.GetSize(), OBXPutMode_PUT);
+    CHECK(id == item.id);
+}
+}  // namespace
+
+void testObjectCache() {
+    obx::Store store(testOptions("testdata-object-cache"));
+    obx::Box<Item> box(store);
+    obx_id id = box.put(newItem("cached", 1));
+    obx_id otherId = box.put(newItem("other", 2));
+
+    // Enabling the cache while another thread reads via the same box
+    std::atomic<int> readErrors{0};
+    std::thread reader([&box, &readErrors, id] {
+        for (int i = 0; i < 1000; i++) {
+            if (box.get(id)->value != 1) readErrors++;
+        }
+    });
+    obx::ObjectCache& cache = box.enableObjectCache(16);
+    reader.join();
+    CHECK(readErrors == 0);
+    CHECK(box.objectCache() == &cache);
+    CHECK(cache.capacity() == 16);
+    CHECK(store.objectCache(Item::_OBX_MetaInfo::entityId()) == &cache);
+    obx::Box<Item> laterBox(store);
+    CHECK(laterBox.objectCache() == &cache);
+
+    // Hits and misses
+    cache.invalidate();
+    uint64_t hits = cache.hits();
+    uint64_t misses = cache.misses();
+    CHECK(box.get(id)->text == "cached");  // Miss, caches the object
+    CHECK(cache.misses() == misses + 1);
+    CHECK(box.get(id)->text == "cached");
+    CHECK(laterBox.get(id)->text == "cached");
+    CHECK(cache.hits() == hits + 2);
+    CHECK(!box.get(otherId + 1));  // Non-existing IDs are not cached
+    CHECK(!box.get(otherId + 1));
+    CHECK(cache.misses() == misses + 3);
+    {
+        obx::Transaction tx = store.txRead();  // Reads in transactions do not use the cache
+        CHECK(box.get(id)->text == "cached");
+        CHECK(cache.hits() == hits + 2);
+        CHECK(cache.misses() == misses + 3);
+    }
+
+    // Commits via this API invalidate the cache right away, i.e. the committing thread reads its own changes
+    Item changed = *box.get(id);
+    changed.value = 10;
+    box.put(changed);
+    CHECK(box.get(id)->value == 10);
+    box.get(otherId);  // Cached
+    {
+        obx::Transaction tx = store.txWrite();
+        obx::Box<Item>(store).put(newItem("in tx", 3));
+        changed.value = 11;
+        box.put(changed);
+        tx.success();
+    }
+    CHECK(box.get(id)->value == 11);
+    CHECK(box.remove(otherId));
+    CHECK(!box.get(otherId));
+
+    // External commits become visible once the observer invalidated the cache; until then, reads may be stale
+    CHECK(box.get(id)->value == 11);  // Cached
+    changed.value = 12;
+    putExternally(box, changed);
+    {
+        obx::Transaction tx = store.txRead();
+        CHECK(box.get(id)->value == 12);  // Transactions always see the committed state
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    int64_t value;
+    while ((value = box.get(id)->value) != 12 && std::chrono::steady_clock::now() < deadline) {
+        CHECK(value == 11);  // Stale, but never anything else
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(value == 12);
+
+    // Explicit invalidation, e.g. right after an external commit that must be read back immediately
+    changed.value = 13;
+    putExternally(box, changed);
+    cache.invalidate();
+    CHECK(box.get(id)->value == 13);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include "objectbox-model.h"
+#include "test_objects.obx.hpp"
+
+/// Fails the current test (by throwing) if the condition is false.
+#define CHECK(condition)                                                                                     \
+    ((condition) ? (void) 0                                                                                  \
+                 : throw std::runtime_error(std::string(__FILE__) + ":" + std::to_string(__LINE__) + ": " + \
+                                            "check failed: " + #condition))
+
+/// Fails the current test if the statement does not throw the given exception type.
+#define CHECK_THROWS(statement, ExceptionT) \
+    do {                                    \
+        bool thrown = false;                \
+        try {                               \
+            statement;                      \
+        } catch (const ExceptionT&) {       \
+            thrown = true;                  \
+        }                                   \
+        CHECK(thrown);                      \
+    } while (false)
+
+/// Opens a store in the given directory after removing any previous database files there.
+inline obx::Options testOptions(const std::string& directory) {
+    obx::Store::removeDbFiles(directory);
+    obx::Options options(create_obx_model());
+    options.directory(directory);
+    return options;
+}
+
+inline Item newItem(const std::string& text, int64_t value) {
+    Item item;
+    item.id = 0;
+    item.text = text;
+    item.value = value;
+    return item;
+}
+
+void testGroupCommit();
+void testIncrementalBackup();
+void testCompactionSparseIds();
+void testBackgroundValidationResume();
+void testObjectCache();
+void testTreeExportImport();
+void testTreeValueIndex();
@@ -0,0 +1,47 @@
+// Code generated by ObjectBox; DO NOT EDIT.
+
+#include "test_objects.obx.hpp"
+
+const obx::Property<Item, OBXPropertyType_Long> Item_::id(1);
+const obx::Property<Item, OBXPropertyType_String> Item_::text(2);
+const obx::Property<Item, OBXPropertyType_Long> Item_::value(3);
+
+void Item::_OBX_MetaInfo::toFlatBuffer(flatbuffers::FlatBufferBuilder& fbb, const Item& object) {
+    fbb.Clear();
+    auto offsettext = fbb.CreateString(object.text);
+    flatbuffers::uoffset_t fbStart = fbb.StartTable();
+    fbb.AddElement(4, object.id);
+    fbb.AddOffset(6, offsettext);
+    fbb.AddElement(8, object.value);
+    flatbuffers::Offset<flatbuffers::Table> offset;
+    offset.o = fbb.EndTable(fbStart);
+    fbb.Finish(offset);
+}
+
+Item Item::_OBX_MetaInfo::fromFlatBuffer(const void* data, size_t size) {
+    Item object;
+    fromFlatBuffer(data, size, object);
+    return object;
+}
+
+std::unique_ptr<Item> Item::_OBX_MetaInfo::newFromFlatBuffer(const void* data, size_t size) {
+    auto object = std::unique_ptr<Item>(new Item());
+    fromFlatBuffer(data, size, *object);
+    return object;
+}
+
+void Item::_OBX_MetaInfo::fromFlatBuffer(const void* data, size_t, Item& outObject) {
+    const auto* table = flatbuffers::GetRoot<flatbuffers::Table>(data);
+    assert(table);
+    outObject.id = table->GetField<obx_id>(4, 0);
+    {
+        auto* ptr = table->GetPointer<const flatbuffers::String*>(6);
+        if (ptr) {
+            outObject.text.assign(ptr->c_str(), ptr->size());
+        } else {
+            outObject.text.clear();
+        }
+    }
+    outObject.value = table->GetField<int64_t>(8, 0);
+}
+
@@ -0,0 +1,44 @@
+// Code generated by ObjectBox; DO NOT EDIT.
+
+#pragma once
+
+#include <cstdbool>
+#include <cstdint>
+
+#include "flatbuffers/flatbuffers.h"
+#include "objectbox.h"
+#include "objectbox.hpp"
+
+
+struct Item_;
+
+struct Item {
+    obx_id id;
+    std::string text;
+    int64_t value;
+
+    struct _OBX_MetaInfo {
+        static constexpr obx_schema_id entityId() { return 1; }
+    
+        static void setObjectId(Item& object, obx_id newId) { object.id = newId; }
+    
+        /// Write given object to the FlatBufferBuilder
+        static void toFlatBuffer(flatbuffers::FlatBufferBuilder& fbb, const Item& object);
+    
+        /// Read an object from a valid FlatBuffer
+        static Item fromFlatBuffer(const void* data, size_t size);
+    
+        /// Read an object from a valid FlatBuffer
+        static std::unique_ptr<Item> newFromFlatBuffer(const void* data, size_t size);
+    
+        /// Read an object from a valid FlatBuffer
+        static void fromFlatBuffer(const void* data, size_t size, Item& outObject);
+    };
+};
+
+struct Item_ {
+    static const obx::Property<Item, OBXPropertyType_Long> id;
+    static const obx::Property<Item, OBXPropertyType_String> text;
+    static const obx::Property<Item, OBXPropertyType_Long> value;
+};
+
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <map>
+
+#include "test.hpp"
+
+namespace {
+/// Builds leaf FlatBuffers with zeroed ID slots (as obx_tree_cursor_put_raw() requires) in the layout assumed by
+/// TreeCursor::importSubtree(): data leaf IDs at field indexes 0-2 (leaf, branch, meta leaf), meta leaf IDs at 0 and 2
+/// (leaf, branch) with the name at 1.
+std::vector<uint8_t> leafBytes(const char* name) {
+    flatbuffers::FlatBufferBuilder fbb;
+    fbb.ForceDefaults(true);  // The ID slots must be present, even if zero
+    flatbuffers::Offset<flatbuffers::String> nameOffset;
+    if (name) nameOffset = fbb.CreateString(name);
+    flatbuffers::uoffset_t start = fbb.StartTable();
+    fbb.AddElement<uint64_t>(4, 0);
+    if (name) fbb.AddOffset(6, nameOffset);
+    if (!name) fbb.AddElement<uint64_t>(6, 0);
+    fbb.AddElement<uint64_t>(8, 0);
+    flatbuffers::Offset<flatbuffers::Table> offset;
+    offset.o = fbb.EndTable(start);
+    fbb.Finish(offset);
+    return std::vector<uint8_t>(fbb.GetBufferPointer(), fbb.GetBufferPointer() + fbb.GetSize());
+}
+
+void putLeaf(obx::TreeCursor& cursor, const char* path, const char* name) {
+    std::vector<uint8_t> data = leafBytes(nullptr);
+    std::vector<uint8_t> metadata = leafBytes(name);
+    obx::TreePutResult result = cursor.put(path, data.data(), data.size(), OBXPropertyType_Long, nullptr,
+                                           metadata.data(), metadata.size());
+    CHECK(result == obx::TreePutResult::Success);
+}
+
+/// @returns the exported leaves by path with their type; IDs differ between stores
+std::map<std::string, OBXPropertyType> exportedLeaves(obx::Tree& tree, obx::Store& store, const char* path) {
+    std::map<std::string, OBXPropertyType> leaves;
+    obx::Transaction tx = store.txRead();
+    obx::TreeCursor cursor(tree, tx);
+    cursor.exportSubtree(path, [&leaves](const obx::TreeLeafExport& leaf) {
+        leaves[leaf.path] = leaf.type;
+        return true;
+    });
+    return leaves;
+}
+}  // namespace
+
+void testTreeExportImport() {
+    obx::Store source(testOptions("testdata-tree-source"));
+    std::unique_ptr<obx::Tree> sourceTree;
+    try {
+        sourceTree.reset(new obx::Tree(source));
+    } catch (const obx::Exception& e) {  // Requires a library with tree support and the tree types in the model
+        printf("  skipped: %s\n", e.what());
+        return;
+    }
+    {
+        obx::Transaction tx = source.txWrite();
+        obx::TreeCursor cursor(*sourceTree, tx);
+        putLeaf(cursor, "config/a", "a");
+        putLeaf(cursor, "config/sub/b", "b");
+        putLeaf(cursor, "other/c", "c");
+        tx.success();
+    }
+
+    std::vector<uint8_t> buffer;
+    {
+        obx::Transaction tx = source.txRead();
+        obx::TreeCursor cursor(*sourceTree, tx);
+        CHECK(cursor.exportSubtree("config", buffer) == 2);
+    }
+
+    obx::Store target(testOptions("testdata-tree-target"));
+    obx::Tree targetTree(target);
+    {
+        obx::Transaction tx = target.txWrite();
+        obx::TreeCursor cursor(targetTree, tx);
+        CHECK(cursor.importSubtree(buffer) == 2);
+        CHECK(cursor.importSubtree(buffer, OBXPutMode_INSERT) == 0);  // Exist already
+        tx.success();
+    }
+    CHECK(exportedLeaves(targetTree, target, nullptr) == exportedLeaves(*sourceTree, source, "config"));
+
+    // A buffer with an invalid header is rejected
+    std::vector<uint8_t> corrupt(buffer);
+    corrupt[3] ^= 1;
+    obx::Transaction tx = target.txWrite();
+    obx::TreeCursor cursor(targetTree, tx);
+    CHECK_THROWS(cursor.importSubtree(corrupt), obx::IllegalArgumentException);
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+
+#include "test.hpp"
+
+namespace {
+/// Uses the raw leaf bytes as the value; enough to test the index bookkeeping without a leaf layout.
+bool rawValue(const void* data, size_t size, std::string& outValue) {
+    if (size == 0) return false;
+    outValue.assign(static_cast<const char*>(data), size);
+    return true;
+}
+
+void updateLeaf(obx::TreeValueIndex& index, const std::string& path, obx_id id, const std::string& value,
+                OBXPropertyType type = OBXPropertyType_String) {
+    index.update(path, id, type, value.data(), value.size());
+}
+}  // namespace
+
+void testTreeValueIndex() {
+    obx::Store store(testOptions("testdata-tree-index"));
+    std::unique_ptr<obx::Tree> tree;
+    try {
+        tree.reset(new obx::Tree(store));
+    } catch (const obx::Exception& e) {  // Requires a library with tree support and the tree types in the model
+        printf("  skipped: %s\n", e.what());
+        return;
+    }
+    const std::string d(1, tree->pathDelimiter());
+
+    // Path pattern matching: "*" matches exactly one non-empty segment
+    obx::TreeValueIndex index(*tree, OBXPropertyType_String, "devices" + d + "*" + d + "firmware", rawValue);
+    CHECK(index.matchesPath("devices" + d + "a" + d + "firmware"));
+    CHECK(index.matchesPath("devices" + d + "device-42" + d + "firmware"));
+    CHECK(!index.matchesPath("devices" + d + d + "firmware"));
+    CHECK(!index.matchesPath("devices" + d + "firmware"));
+    CHECK(!index.matchesPath("devices" + d + "a" + d + "b" + d + "firmware"));
+    CHECK(!index.matchesPath("devices" + d + "a" + d + "firmware" + d + "x"));
+    CHECK(!index.matchesPath("devices" + d + "a" + d + "firmwar"));
+    CHECK(!index.matchesPath("other" + d + "a" + d + "firmware"));
+
+    obx::TreeValueIndex leadingWildcard(*tree, OBXPropertyType_String, "*" + d + "*", rawValue);
+    CHECK(leadingWildcard.matchesPath("a" + d + "b"));
+    CHECK(!leadingWildcard.matchesPath("a"));
+    CHECK(!leadingWildcard.matchesPath("a" + d + "b" + d + "c"));
+
+    obx::TreeValueIndex all(*tree, OBXPropertyType_String, "", rawValue);
+    CHECK(all.matchesPath("a"));
+    CHECK(all.matchesPath("a" + d + "b" + d + "c"));
+
+    CHECK_THROWS(obx::TreeValueIndex(*tree, OBXPropertyType_String, "devices" + d + d + "x", rawValue),
+                 obx::IllegalArgumentException);
+
+    // Updates and removals
+    const std::string pathA = "devices" + d + "a" + d + "firmware";
+    const std::string pathB = "devices" + d + "b" + d + "firmware";
+    updateLeaf(index, pathA, 1, "1.2");
+    updateLeaf(index, pathB, 2, "1.2");
+    updateLeaf(index, "other" + d + "c" + d + "firmware", 3, "1.2");  // Path not matching
+    updateLeaf(index, "devices" + d + "c" + d + "firmware", 4, "1.2", OBXPropertyType_Int);  // Type not matching
+    CHECK(index.size() == 2);
+    CHECK(index.count("1.2") == 2);
+    std::vector<obx::TreeIndexedLeaf> found = index.find("1.2");
+    CHECK(found.size() == 2);
+    CHECK(found[0].path == pathA && found[0].id == 1);  // Ordered by path
+    CHECK(found[1].path == pathB && found[1].id == 2);
+
+    updateLeaf(index, pathA, 1, "1.3");  // Changing the value moves the leaf to the new value
+    CHECK(index.size() == 2);
+    CHECK(index.findIds("1.2") == std::vector<obx_id>{2});
+    CHECK(index.findIds("1.3") == std::vector<obx_id>{1});
+
+    updateLeaf(index, pathA, 1, "");  // Not indexed by the extractor anymore
+    CHECK(index.size() == 1);
+    CHECK(index.count("1.3") == 0);
+
+    updateLeaf(index, pathA, 1, "1.3", OBXPropertyType_Int);  // Changed to a non-indexed type
+    CHECK(index.size() == 1);
+    CHECK(index.count("1.3") == 0);
+
+    index.remove(pathB);
+    CHECK(index.size() == 0);
+    CHECK(index.count("1.2") == 0);
+    CHECK(index.find("1.2").empty());
+    index.remove(pathB);  // Removing a non-indexed path is a no-op
+    CHECK(index.size() == 0);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2018-2024 ObjectBox Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+namespace {
+const obx_schema_id itemTypeId = Item::_OBX_MetaInfo::entityId();
+
+void testResumeFromSavedPosition(obx::Store& store, const std::vector<obx_id>& ids) {
+    // Saved after visiting the first half; the last visited object was removed meanwhile
+    obx::Box<Item>(store).remove(ids[499]);
+    obx::BackgroundValidation validation(store, {itemTypeId});
+    validation.maxObjectsPerTransaction(100).resumeFrom({{itemTypeId, ids[499], false, 0}}).start();
+    validation.awaitFinished();
+    CHECK(validation.isFinished());
+    CHECK(validation.checkedCount() == 500);
+    CHECK(validation.issueCount() == 0);
+}
+
+/// Stops a validation at some point and resumes from its positions with a new one: each object is checked once.
+void testStopAndResume(obx::Store& store, size_t threadCount) {
+    uint64_t objectCount = obx::Box<Item>(store).count();
+    obx::BackgroundValidation first(store, {itemTypeId});
+    first.threads(threadCount).objectsPerRange(100).maxObjectsPerTransaction(10).start();
+    first.stop();  // Likely before it finished; either way, the positions reflect what was checked
+    std::vector<obx::ValidationPosition> positions = first.positions();
+
+    obx::BackgroundValidation second(store, {itemTypeId});
+    second.threads(threadCount).objectsPerRange(100).maxObjectsPerTransaction(10).resumeFrom(positions).start();
+    second.awaitFinished();
+    CHECK(second.isFinished());
+    CHECK(first.checkedCount() + second.checkedCount() == objectCount);
+    CHECK(first.issueCount() + second.issueCount() == 0);
+}
+}  // namespace
+
+void testBackgroundValidationResume() {
+    obx::Store store(testOptions("testdata-validation"));
+    std::vector<Item> items;
+    for (int64_t i = 0; i < 1000; i++) items.push_back(newItem("item " + std::to_string(i), i));
+    std::vector<obx_id> ids;
+    obx::Box<Item>(store).put(items, &ids);
+
+    testResumeFromSavedPosition(store, ids);
+    testStopAndResume(store, 1);
+    testStopAndResume(store, 4);
+}
@@ -38,5 +38,6 @@ cmake --build .
 
 (cd src-test/${buildSubDir} && ${testPrepCmd} && ./objectbox-c-test)
 (cd src-test-gen/${buildSubDir} && ${testPrepCmd} && ./objectbox-c-gen-test)
+(cd src-test-cpp/${buildSubDir} && ${testPrepCmd} && ./objectbox-c-cpp-test)
 
 echo "Done. All looks good. Welcome to ObjectBox! :)"